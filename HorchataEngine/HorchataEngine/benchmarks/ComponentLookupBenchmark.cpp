@@ -0,0 +1,126 @@
+/**
+ * @file ComponentLookupBenchmark.cpp
+ * @brief Compares Entity::getComponent<T> against the previous lookup, a linear
+ * scan that ran dynamic_pointer_cast on every component of the entity.
+ *
+ * Only header code of the engine is used, so it builds without the SFML libraries:
+ *   g++ -std=c++17 -O2 -I include -I <SFML>/include -I <imgui-sfml>
+ *       benchmarks/ComponentLookupBenchmark.cpp src/ECS/Registry.cpp
+ */
+#include "ECS/Entity.h"
+#include "ECS/Transform.h"
+#include <chrono>
+
+namespace {
+  /**
+   * @brief Stand-in for a referenced component (shape, texture, ...).
+   */
+  template<int N>
+  class
+    BenchComponent : public Component {
+  public:
+    void beginplay() override {}
+    void update(float) override {}
+    void render(const EngineUtilities::TSharedPointer<Window>&) override {}
+    void destroy() override {}
+    int value = N;
+  };
+
+  class
+    BenchEntity : public Entity {
+  public:
+    void beginplay() override {}
+    void update(float) override {}
+    void render(const EngineUtilities::TSharedPointer<Window>&) override {}
+    void destroy() override {}
+  };
+
+  /**
+   * @brief The lookup Entity::getComponent used before the slot table.
+   */
+  template<typename T>
+  EngineUtilities::TSharedPointer<T>
+    legacyGetComponent(std::vector<EngineUtilities::TSharedPointer<Component>>& components) {
+    for (auto& component : components) {
+      EngineUtilities::TSharedPointer<T> specificComponent = component.template dynamic_pointer_cast<T>();
+      if (specificComponent) {
+        return specificComponent;
+      }
+    }
+    return EngineUtilities::TSharedPointer<T>();
+  }
+
+  template<typename Func>
+  double
+    measureNanoseconds(size_t lookups, Func&& func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / lookups;
+  }
+}
+
+int
+main() {
+  const size_t entityCount = 10000;
+  const int passes = 100;
+  const size_t lookups = entityCount * passes;
+
+  // Same layout as an Actor before the Registry: shape, transform, texture
+  std::vector<std::vector<EngineUtilities::TSharedPointer<Component>>> legacy(entityCount);
+  std::vector<EngineUtilities::TSharedPointer<BenchEntity>> entities;
+  entities.reserve(entityCount);
+
+  for (size_t i = 0; i < entityCount; ++i) {
+    legacy[i].push_back(EngineUtilities::MakeShared<BenchComponent<0>>());
+    legacy[i].push_back(EngineUtilities::MakeShared<Transform>());
+    legacy[i].push_back(EngineUtilities::MakeShared<BenchComponent<1>>());
+
+    auto entity = EngineUtilities::MakeShared<BenchEntity>();
+    entity->addComponent(EngineUtilities::MakeShared<BenchComponent<0>>());
+    entity->emplaceComponent<Transform>();
+    entity->addComponent(EngineUtilities::MakeShared<BenchComponent<1>>());
+    entities.push_back(entity);
+  }
+
+  volatile float sink = 0.0f;
+
+  double legacyTransform = measureNanoseconds(lookups, [&]() {
+    for (int pass = 0; pass < passes; ++pass) {
+      for (auto& components : legacy) {
+        sink = sink + legacyGetComponent<Transform>(components)->getPosition().x;
+      }
+    }
+  });
+
+  double slotTransform = measureNanoseconds(lookups, [&]() {
+    for (int pass = 0; pass < passes; ++pass) {
+      for (auto& entity : entities) {
+        sink = sink + entity->getComponent<Transform>()->getPosition().x;
+      }
+    }
+  });
+
+  double legacyReferenced = measureNanoseconds(lookups, [&]() {
+    for (int pass = 0; pass < passes; ++pass) {
+      for (auto& components : legacy) {
+        sink = sink + static_cast<float>(legacyGetComponent<BenchComponent<1>>(components)->value);
+      }
+    }
+  });
+
+  double slotReferenced = measureNanoseconds(lookups, [&]() {
+    for (int pass = 0; pass < passes; ++pass) {
+      for (auto& entity : entities) {
+        sink = sink + static_cast<float>(entity->getComponent<BenchComponent<1>>()->value);
+      }
+    }
+  });
+
+  std::cout << "Component lookup, " << entityCount << " entities x " << passes << " passes\n";
+  std::cout << "  Transform (dense)      legacy scan: " << legacyTransform
+            << " ns   slot table: " << slotTransform << " ns\n";
+  std::cout << "  Referenced component   legacy scan: " << legacyReferenced
+            << " ns   slot table: " << slotReferenced << " ns\n";
+  return 0;
+}
@@ -0,0 +1,388 @@
+/**
+ * @file FlockingBenchmark.cpp
+ * @brief Scaling of the neighbour steering behaviors from a handful to tens of thousands of agents.
+ *
+ * Every scenario scatters N agents at the same density over a square walled
+ * arena and steps them the way SteeringSystem does: index the positions in a
+ * SpatialHashGrid, run WallAvoidance, Separation, Alignment and Cohesion
+ * through SteeringCombiner over the arrays, integrate. Since the density is
+ * fixed, time per agent should stay flat as N grows. For reference, the same
+ * neighbour counts are also gathered with an all-pairs scan (up to --brute-max
+ * agents), which grows with N; the two counts must match.
+ *
+ * Links the engine sources, see benchmarks/CMakeLists.txt:
+ *   FlockingBenchmark --sizes 10,100,1000,10000,50000 --csv flocking.csv
+ */
+#include "SteeringBehaviors.h"
+#include "ECS/SpatialHashGrid.h"
+#include "Threading/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+namespace {
+  /**
+   * @brief Command line options.
+   */
+  struct Options {
+    std::vector<size_t> sizes = { 10, 100, 1000, 10000, 50000 };
+    size_t frames = 120;
+    size_t warmup = 10;
+    uint32_t seed = 1234;
+    float timeStep = 1.f / 120.f;
+    float spacing = 30.f;     /**< Mean distance between agents, sets the arena size. */
+    size_t bruteMax = 10000;  /**< Largest size the all-pairs reference runs at. */
+    std::string csvFile;
+  };
+
+  /**
+   * @brief Timed phases, in report order.
+   */
+  const char* const PHASES[] = { "grid", "steering", "integrate", "frame" };
+  constexpr size_t PHASE_COUNT = sizeof(PHASES) / sizeof(PHASES[0]);
+
+  constexpr size_t GRAIN_SIZE = 256;
+  constexpr float NEIGHBOR_RADIUS = 80.f;
+  constexpr unsigned int MASK_SIZE = 256;
+  constexpr unsigned int WALL_PIXELS = 8;
+
+  /**
+   * @brief Median and tail of one phase, in microseconds.
+   */
+  struct PhaseStats {
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double max = 0.0;
+  };
+
+  /**
+   * @brief Results of one agent count.
+   */
+  struct ScenarioResult {
+    size_t agents = 0;
+    PhaseStats phases[PHASE_COUNT];
+    double meanNeighbors = 0.0;
+    double gridQueryMicroseconds = 0.0;  /**< One neighbour count pass through the grid. */
+    double bruteMicroseconds = -1.0;     /**< Same pass with the all-pairs scan, -1 if skipped. */
+    bool countsMatch = true;
+  };
+
+  /**
+   * @brief Agents of one scenario as the arrays SteeringBatch points to.
+   */
+  struct Agents {
+    std::vector<EngineMath::Vector2> positions;
+    std::vector<EngineMath::Vector2> velocities;
+    std::vector<float> maxSpeeds;
+    std::vector<float> maxForces;
+    std::vector<uint32_t> waypoints;
+    std::vector<EngineMath::Vector2> forces;
+    std::vector<EngineMath::Vector2> behaviorForces;
+    std::vector<EngineMath::Vector2> levelForces;
+    std::vector<float> budgets;
+    std::vector<EngineMath::Vector2> scratchVectors;
+    std::vector<float> scratchFloats;
+
+    void
+      resize(size_t count) {
+      positions.resize(count);
+      velocities.resize(count);
+      maxSpeeds.assign(count, 250.f);
+      maxForces.assign(count, 500.f);
+      waypoints.assign(count, 0);
+      forces.resize(count);
+      behaviorForces.resize(count);
+      levelForces.resize(count);
+      budgets.resize(count);
+      scratchVectors.resize(count);
+      scratchFloats.resize(count);
+    }
+
+    SteeringBatch
+      makeBatch() {
+      SteeringBatch batch;
+      batch.positions = positions.data();
+      batch.velocities = velocities.data();
+      batch.maxSpeeds = maxSpeeds.data();
+      batch.maxForces = maxForces.data();
+      batch.waypoints = waypoints.data();
+      batch.forces = forces.data();
+      batch.behaviorForces = behaviorForces.data();
+      batch.levelForces = levelForces.data();
+      batch.budgets = budgets.data();
+      batch.scratchVectors = scratchVectors.data();
+      batch.scratchFloats = scratchFloats.data();
+      return batch;
+    }
+  };
+
+  std::vector<size_t>
+    parseSizes(const char* text) {
+    std::vector<size_t> sizes;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+      if (!item.empty()) {
+        sizes.push_back(static_cast<size_t>(std::strtoull(item.c_str(), nullptr, 10)));
+      }
+    }
+    return sizes;
+  }
+
+  /**
+   * @brief Mask of a square arena: road inside, a band of death zone along the border.
+   */
+  EngineUtilities::TSharedPointer<TrackCollisionMask>
+    buildArenaMask(float arenaSize) {
+    std::vector<uint8_t> pixels(static_cast<size_t>(MASK_SIZE) * MASK_SIZE * 4, 255);
+    for (unsigned int y = 0; y < MASK_SIZE; ++y) {
+      for (unsigned int x = 0; x < MASK_SIZE; ++x) {
+        if (x < WALL_PIXELS || y < WALL_PIXELS || x >= MASK_SIZE - WALL_PIXELS || y >= MASK_SIZE - WALL_PIXELS) {
+          uint8_t* pixel = &pixels[(static_cast<size_t>(y) * MASK_SIZE + x) * 4];
+          pixel[0] = pixel[1] = pixel[2] = 0;
+        }
+      }
+    }
+    EngineUtilities::TSharedPointer<TrackCollisionMask> mask = EngineUtilities::MakeShared<TrackCollisionMask>();
+    mask->build(MASK_SIZE, MASK_SIZE, pixels.data(), sf::Color::Black);
+    mask->buildDistanceField();
+    mask->setWorldBounds(EngineMath::Vector2(0.f, 0.f), EngineMath::Vector2(arenaSize, arenaSize));
+    return mask;
+  }
+
+  PhaseStats
+    computeStats(std::vector<double> samples) {
+    PhaseStats stats;
+    if (samples.empty()) {
+      return stats;
+    }
+    std::sort(samples.begin(), samples.end());
+    // Nearest rank
+    auto percentile = [&samples](double p) {
+      size_t rank = static_cast<size_t>(std::ceil(p * samples.size()));
+      return samples[rank > 0 ? rank - 1 : 0];
+    };
+    stats.p50 = percentile(0.50);
+    stats.p90 = percentile(0.90);
+    stats.max = samples.back();
+    return stats;
+  }
+
+  /**
+   * @brief Runs one agent count and measures every phase per frame.
+   */
+  ScenarioResult
+    runScenario(size_t agentCount, const Options& options) {
+    using Clock = std::chrono::steady_clock;
+    auto microseconds = [](Clock::time_point start, Clock::time_point end) {
+      return std::chrono::duration<double, std::micro>(end - start).count();
+    };
+
+    // Same density at every size: the arena grows with the square root of the count
+    const float arenaSize = options.spacing * std::sqrt(static_cast<float>(agentCount)) + 4.f * NEIGHBOR_RADIUS;
+    const float margin = arenaSize * WALL_PIXELS / MASK_SIZE + NEIGHBOR_RADIUS * 0.5f;
+    std::mt19937 random(options.seed);
+    std::uniform_real_distribution<float> place(margin, arenaSize - margin);
+    std::uniform_real_distribution<float> speed(-200.f, 200.f);
+
+    Agents agents;
+    agents.resize(agentCount);
+    for (size_t i = 0; i < agentCount; ++i) {
+      agents.positions[i] = EngineMath::Vector2(place(random), place(random));
+      agents.velocities[i] = EngineMath::Vector2(speed(random), speed(random));
+    }
+
+    // The same stack a flocking racer would get: walls first, then room, then the flock
+    WallAvoidance wallAvoidance(buildArenaMask(arenaSize));
+    Separation separation(NEIGHBOR_RADIUS * 0.5f);
+    Alignment alignment(NEIGHBOR_RADIUS);
+    Cohesion cohesion(NEIGHBOR_RADIUS);
+    std::vector<WeightedSteering> behaviors = {
+      { &wallAvoidance, 1.f, 2 },
+      { &separation, 1.f, 1 },
+      { &alignment, 0.5f, 0 },
+      { &cohesion, 0.5f, 0 }
+    };
+    std::sort(behaviors.begin(), behaviors.end());
+
+    SpatialHashGrid grid(NEIGHBOR_RADIUS * 2.f);
+    ThreadPool& threadPool = ThreadPool::getInstance();
+    std::vector<double> samples[PHASE_COUNT];
+    const size_t totalFrames = options.warmup + options.frames;
+    for (size_t frame = 0; frame < totalFrames; ++frame) {
+      const Clock::time_point frameStart = Clock::now();
+      grid.clear();
+      for (size_t i = 0; i < agentCount; ++i) {
+        grid.insert(static_cast<EntityID>(i), agents.positions[i]);
+      }
+      grid.build();
+
+      const Clock::time_point steeringStart = Clock::now();
+      SteeringBatch batch = agents.makeBatch();
+      batch.neighbors = &grid;
+      threadPool.parallelFor(agentCount, GRAIN_SIZE, [&behaviors, &batch](size_t begin, size_t end) {
+        SteeringCombiner::combine(behaviors, batch, begin, end);
+      });
+
+      const Clock::time_point integrateStart = Clock::now();
+      threadPool.parallelFor(agentCount, GRAIN_SIZE, [&agents, &options](size_t begin, size_t end) {
+        SteeringCombiner::integrate(agents.positions.data() + begin, agents.velocities.data() + begin,
+                                    agents.forces.data() + begin, agents.maxSpeeds.data() + begin,
+                                    end - begin, options.timeStep);
+      });
+      const Clock::time_point frameEnd = Clock::now();
+
+      if (frame < options.warmup) {
+        continue;
+      }
+      samples[0].push_back(microseconds(frameStart, steeringStart));
+      samples[1].push_back(microseconds(steeringStart, integrateStart));
+      samples[2].push_back(microseconds(integrateStart, frameEnd));
+      samples[3].push_back(microseconds(frameStart, frameEnd));
+    }
+
+    ScenarioResult result;
+    result.agents = agentCount;
+    for (size_t phase = 0; phase < PHASE_COUNT; ++phase) {
+      result.phases[phase] = computeStats(std::move(samples[phase]));
+    }
+
+    // Neighbour counts of the final positions, through the grid and all pairs
+    grid.clear();
+    for (size_t i = 0; i < agentCount; ++i) {
+      grid.insert(static_cast<EntityID>(i), agents.positions[i]);
+    }
+    grid.build();
+    const Clock::time_point gridStart = Clock::now();
+    uint64_t gridPairs = 0;
+    for (size_t i = 0; i < agentCount; ++i) {
+      grid.queryRadius(agents.positions[i], NEIGHBOR_RADIUS, [&gridPairs, i](const SpatialHashGrid::Entry& entry) {
+        gridPairs += entry.id != i ? 1 : 0;
+      });
+    }
+    result.gridQueryMicroseconds = microseconds(gridStart, Clock::now());
+    result.meanNeighbors = agentCount > 0 ? static_cast<double>(gridPairs) / agentCount : 0.0;
+
+    if (agentCount <= options.bruteMax) {
+      const Clock::time_point bruteStart = Clock::now();
+      uint64_t brutePairs = 0;
+      const float radiusSq = NEIGHBOR_RADIUS * NEIGHBOR_RADIUS;
+      for (size_t i = 0; i < agentCount; ++i) {
+        for (size_t j = 0; j < agentCount; ++j) {
+          brutePairs += j != i && (agents.positions[j] - agents.positions[i]).lengthSq() <= radiusSq ? 1 : 0;
+        }
+      }
+      result.bruteMicroseconds = microseconds(bruteStart, Clock::now());
+      result.countsMatch = brutePairs == gridPairs;
+    }
+    return result;
+  }
+
+  bool
+    writeCsv(const std::string& fileName, const Options& options, const std::vector<ScenarioResult>& results) {
+    std::ofstream output(fileName, std::ios::trunc);
+    if (!output) {
+      return false;
+    }
+    output.setf(std::ios::fixed);
+    output.precision(3);
+    output << "seed,agents,phase,p50_us,p90_us,max_us,p50_ns_per_agent\n";
+    for (const ScenarioResult& result : results) {
+      for (size_t phase = 0; phase < PHASE_COUNT; ++phase) {
+        const PhaseStats& stats = result.phases[phase];
+        output << options.seed << "," << result.agents << "," << PHASES[phase] << ","
+               << stats.p50 << "," << stats.p90 << "," << stats.max << ","
+               << stats.p50 * 1000.0 / std::max<size_t>(result.agents, 1) << "\n";
+      }
+      output << options.seed << "," << result.agents << ",neighborsGrid,"
+             << result.gridQueryMicroseconds << ",,,"
+             << result.gridQueryMicroseconds * 1000.0 / std::max<size_t>(result.agents, 1) << "\n";
+      if (result.bruteMicroseconds >= 0.0) {
+        output << options.seed << "," << result.agents << ",neighborsBrute,"
+               << result.bruteMicroseconds << ",,,"
+               << result.bruteMicroseconds * 1000.0 / std::max<size_t>(result.agents, 1) << "\n";
+      }
+    }
+    return static_cast<bool>(output);
+  }
+}
+
+/**
+ * Usage: FlockingBenchmark [--sizes 10,100,1000,10000,50000] [--frames N] [--warmup N]
+ *                          [--seed S] [--timestep SECONDS] [--spacing UNITS]
+ *                          [--brute-max N] [--csv FILE]
+ * Exits with 1 if the grid and the all-pairs scan find different neighbours.
+ */
+int
+main(int argc, char* argv[]) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--sizes") == 0 && hasValue) {
+      options.sizes = parseSizes(argv[++i]);
+    }
+    else if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+      options.frames = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+    }
+    else if (std::strcmp(argv[i], "--warmup") == 0 && hasValue) {
+      options.warmup = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+    }
+    else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+      options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    }
+    else if (std::strcmp(argv[i], "--timestep") == 0 && hasValue) {
+      options.timeStep = std::strtof(argv[++i], nullptr);
+    }
+    else if (std::strcmp(argv[i], "--spacing") == 0 && hasValue) {
+      options.spacing = std::strtof(argv[++i], nullptr);
+    }
+    else if (std::strcmp(argv[i], "--brute-max") == 0 && hasValue) {
+      options.bruteMax = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+    }
+    else if (std::strcmp(argv[i], "--csv") == 0 && hasValue) {
+      options.csvFile = argv[++i];
+    }
+    else {
+      std::cerr << "Unknown option: " << argv[i] << "\n";
+      return 1;
+    }
+  }
+  if (options.frames == 0 || options.timeStep <= 0.f || options.spacing <= 0.f) {
+    std::cerr << "--frames, --timestep and --spacing must be positive\n";
+    return 1;
+  }
+
+  std::vector<ScenarioResult> results;
+  bool countsMatch = true;
+  for (size_t size : options.sizes) {
+    results.push_back(runScenario(size, options));
+    const ScenarioResult& result = results.back();
+    countsMatch = countsMatch && result.countsMatch;
+
+    const double perAgent = 1000.0 / std::max<size_t>(result.agents, 1);
+    std::cout << "Flocking: " << result.agents << " agents, " << result.meanNeighbors
+              << " neighbours on average, " << options.frames << " frames\n";
+    for (size_t phase = 0; phase < PHASE_COUNT; ++phase) {
+      const PhaseStats& stats = result.phases[phase];
+      std::cout << "  " << PHASES[phase] << std::string(16 - std::strlen(PHASES[phase]), ' ')
+                << "p50 " << stats.p50 << " us   p90 " << stats.p90 << " us   max " << stats.max
+                << " us   " << stats.p50 * perAgent << " ns/agent\n";
+    }
+    std::cout << "  neighborsGrid   " << result.gridQueryMicroseconds << " us   "
+              << result.gridQueryMicroseconds * perAgent << " ns/agent\n";
+    if (result.bruteMicroseconds >= 0.0) {
+      std::cout << "  neighborsBrute  " << result.bruteMicroseconds << " us   "
+                << result.bruteMicroseconds * perAgent << " ns/agent"
+                << (result.countsMatch ? "" : "   MISMATCH") << "\n";
+    }
+  }
+
+  if (!options.csvFile.empty() && !writeCsv(options.csvFile, options, results)) {
+    std::cerr << "Can't write " << options.csvFile << "\n";
+    return 1;
+  }
+  return countsMatch ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file ResourceTableBenchmark.cpp
+ * @brief Generational handles and LRU eviction of TResourceTable, and the cost of
+ * resolving a handle against looking the resource up by name.
+ *
+ * The program exits with 1 when a stale handle still resolves or eviction drops
+ * the wrong resource, so it doubles as the test of TResourceTable.
+ *   g++ -std=c++17 -O2 -I include -I <SFML>/include -I <imgui-sfml>
+ *       benchmarks/ResourceTableBenchmark.cpp
+ */
+#include "ResourceTable.h"
+#include <chrono>
+#include <iostream>
+
+namespace {
+  /**
+   * @brief Stand-in for a texture, only its identity matters.
+   */
+  struct BenchResource {
+    int id = 0;
+  };
+
+  using Table = TResourceTable<BenchResource>;
+
+  constexpr size_t RESOURCE_BYTES = 1024;
+
+  bool
+    check(bool condition, const char* what) {
+    if (!condition) {
+      std::cout << "  FAILED: " << what << "\n";
+    }
+    return condition;
+  }
+
+  THandle<BenchResource>
+    insertResource(Table& table, const std::string& name, int id) {
+    auto resource = EngineUtilities::MakeShared<BenchResource>();
+    resource->id = id;
+    return table.insert(name, resource, RESOURCE_BYTES);
+  }
+
+  /**
+   * @brief An evicted handle stops resolving, and the slot comes back with a new generation.
+   */
+  bool
+    checkGenerations() {
+    Table table;
+    auto first = insertResource(table, "first", 1);
+    table.nextFrame();
+
+    bool passed = true;
+    passed &= check(table.evict(0) == 1, "unused resource is evicted");
+    passed &= check(!table.isValid(first), "evicted handle is stale");
+    passed &= check(table.get(first).isNull(), "stale handle resolves to nothing");
+    passed &= check(!table.find("first").isValid(), "evicted name is not found");
+
+    auto second = insertResource(table, "second", 2);
+    passed &= check(second.index == first.index, "freed slot is reused");
+    passed &= check(second.generation != first.generation && second != first, "reused slot bumps its generation");
+    passed &= check(table.get(first).isNull(), "old handle does not resolve to the new resource");
+    passed &= check(!table.get(second).isNull() && table.get(second)->id == 2, "new handle resolves");
+
+    // Replacing a resource by name keeps its slot and generation
+    auto replaced = insertResource(table, "second", 3);
+    passed &= check(replaced == second && table.get(second)->id == 3, "replace keeps the handle");
+
+    std::cout << "  generations: " << (passed ? "ok" : "FAILED") << "\n";
+    return passed;
+  }
+
+  /**
+   * @brief Eviction drops the least recently used resource first, and never one that
+   * was used this frame or that something else still references.
+   */
+  bool
+    checkEvictionOrder() {
+    Table table;
+    auto oldest = insertResource(table, "oldest", 1);
+    auto middle = insertResource(table, "middle", 2);
+    auto newest = insertResource(table, "newest", 3);
+
+    // Insertion order is oldest, middle, newest; use them in the opposite order
+    table.nextFrame();
+    table.get(newest);
+    table.nextFrame();
+    table.touch(middle);
+    table.nextFrame();
+    table.touch(oldest);
+    table.nextFrame();
+
+    bool passed = true;
+    passed &= check(table.evict(2 * RESOURCE_BYTES) == 1, "one resource over budget");
+    passed &= check(!table.isValid(newest), "least recently used goes first");
+    passed &= check(table.isValid(middle) && table.isValid(oldest), "recently used resources stay");
+    passed &= check(table.evict(RESOURCE_BYTES) == 1 && !table.isValid(middle), "then the next least recent");
+    passed &= check(table.isValid(oldest), "most recently used stays");
+
+    // Used this frame: kept even over budget
+    table.touch(oldest);
+    passed &= check(table.evict(0) == 0 && table.isValid(oldest), "resource used this frame stays");
+
+    // Referenced elsewhere (a shape holds it): kept even over budget
+    table.nextFrame();
+    auto held = table.get(oldest);
+    table.nextFrame();
+    passed &= check(table.evict(0) == 0 && table.isValid(oldest), "referenced resource stays");
+    held.reset();
+    passed &= check(table.evict(0) == 1 && table.getResidentBytes() == 0, "released resource is evicted");
+
+    std::cout << "  eviction order: " << (passed ? "ok" : "FAILED") << "\n";
+    return passed;
+  }
+
+  /**
+   * @brief Time of resolving every resource by handle and by name.
+   */
+  void
+    measureLookup(size_t count) {
+    Table table;
+    std::vector<THandle<BenchResource>> handles;
+    std::vector<std::string> names;
+    for (size_t i = 0; i < count; ++i) {
+      names.push_back("Sprites/Resource_" + std::to_string(i));
+      handles.push_back(insertResource(table, names.back(), static_cast<int>(i)));
+    }
+
+    const int passes = 200;
+    volatile uint32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+      for (const auto& handle : handles) {
+        sink = sink + static_cast<uint32_t>(table.get(handle)->id);
+      }
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+      for (const auto& name : names) {
+        sink = sink + static_cast<uint32_t>(table.get(table.find(name))->id);
+      }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    const double lookups = static_cast<double>(count) * passes;
+    std::cout << "  " << count << " resources  handle: "
+              << std::chrono::duration<double, std::nano>(middle - start).count() / lookups << " ns"
+              << "  name: " << std::chrono::duration<double, std::nano>(end - middle).count() / lookups << " ns\n";
+  }
+}
+
+int
+main() {
+  std::cout << "TResourceTable\n";
+  bool passed = true;
+  passed &= checkGenerations();
+  passed &= checkEvictionOrder();
+
+  for (size_t count : { 16, 256, 4096 }) {
+    measureLookup(count);
+  }
+
+  std::cout << (passed ? "All checks passed\n" : "Some checks failed\n");
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,615 @@
+/**
+ * @file SceneBenchmark.cpp
+ * @brief Headless frame benchmark on procedurally generated race scenes.
+ *
+ * Every scenario builds a closed track from a seed (waypoints, collision image),
+ * N ARacers with PathFollowing, N static actors and a player, then steps the
+ * same phases BaseApp runs at a fixed timestep and reports percentiles of every
+ * phase. The same seed always gives the same scene, so runs can be compared
+ * commit to commit from the JSON or CSV output.
+ *
+ * It also checks the batching: every shape of the generated scenes is untextured,
+ * so each frame must take one draw call per layer whatever the racer count; N
+ * outlined untextured shapes must take a single draw call; and N outlined shapes
+ * spread over two textures must take three (one per texture plus the outlines),
+ * with texture coordinates that map each shape onto its texture rect. The
+ * program exits with 1 when any check fails.
+ *
+ * Links the engine sources, see benchmarks/CMakeLists.txt:
+ *   SceneBenchmark --sizes 10,100,1000 --frames 600 --json scene.json --csv scene.csv
+ */
+#include "GameManager.h"
+#include "SpriteBatch.h"
+#include "AssetCache.h"
+#include "Profiler.h"
+#include "ECS/SteeringSystem.h"
+#include "Threading/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+
+namespace {
+  /**
+   * @brief Plain data component stored in the Registry, to vary the columns per archetype.
+   */
+  template<int N>
+  struct BenchComponent {
+    float value[4] = { float(N), 0.f, 0.f, 0.f };
+  };
+
+  /**
+   * @brief Most extra components an actor can get (one BenchComponent type each).
+   */
+  constexpr int MAX_EXTRA_COMPONENTS = 8;
+
+  template<int N>
+  void
+    addExtraComponents(Actor& actor, int count) {
+    if constexpr (N < MAX_EXTRA_COMPONENTS) {
+      if (N < count) {
+        Registry::getInstance().emplace<BenchComponent<N>>(actor.getEntityID());
+        addExtraComponents<N + 1>(actor, count);
+      }
+    }
+  }
+
+  /**
+   * @brief Command line options.
+   */
+  struct Options {
+    std::vector<size_t> sizes = { 10, 100, 1000 };
+    long staticActors = -1; /**< Static actors per scenario, -1 uses the racer count. */
+    int components = 0;     /**< Extra components per actor. */
+    size_t frames = 600;
+    size_t warmup = 60;
+    uint32_t seed = 1234;
+    float timeStep = 1.f / 120.f;
+    std::string label;
+    std::string jsonFile;
+    std::string csvFile;
+  };
+
+  /**
+   * @brief Timed phases, in report order. progress, ranking and trackCollision are nested in
+   * gameManager and read from the profiler zones of GameManager.
+   */
+  const char* const PHASES[] = {
+    "update", "steering", "gameManager", "progress", "ranking", "trackCollision", "racerCollision", "renderPrep", "frame"
+  };
+  constexpr size_t PHASE_COUNT = sizeof(PHASES) / sizeof(PHASES[0]);
+
+  /**
+   * @brief Percentiles of one phase, in microseconds.
+   */
+  struct PhaseStats {
+    double mean = 0.0;
+    double min = 0.0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+  };
+
+  /**
+   * @brief Results of one scene size.
+   */
+  struct ScenarioResult {
+    size_t racers = 0;
+    size_t staticActors = 0;
+    PhaseStats phases[PHASE_COUNT];
+    uint64_t maxFrameAllocations = 0;
+    size_t drawCalls = 0; /**< Draw calls of the last frame. */
+  };
+
+  /**
+   * @brief Draw calls a generated scene must take: track and scenery on layer 0, karts on layer 1.
+   */
+  constexpr size_t SCENE_DRAW_CALLS = 2;
+
+  /**
+   * @brief Procedurally generated scene.
+   */
+  struct Scene {
+    std::vector<EngineMath::Vector2> waypoints;
+    EngineUtilities::TSharedPointer<Path> path;
+    EngineUtilities::TSharedPointer<Actor> track;
+    EngineUtilities::TSharedPointer<APlayer> player;
+    std::vector<EngineUtilities::TSharedPointer<ARacer>> racers;
+    std::vector<EngineUtilities::TSharedPointer<Actor>> staticActors;
+    EngineUtilities::TSharedPointer<GameManager> gameManager;
+  };
+
+  const EngineMath::Vector2 WORLD_SIZE(1920.f, 1080.f);
+  constexpr float ROAD_HALF_WIDTH = 70.f;
+
+  std::vector<size_t>
+    parseSizes(const char* text) {
+    std::vector<size_t> sizes;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+      if (!item.empty()) {
+        sizes.push_back(static_cast<size_t>(std::strtoull(item.c_str(), nullptr, 10)));
+      }
+    }
+    return sizes;
+  }
+
+  /**
+   * @brief Distance from a point to the segment ab.
+   */
+  float
+    segmentDistance(const EngineMath::Vector2& p, const EngineMath::Vector2& a, const EngineMath::Vector2& b) {
+    const EngineMath::Vector2 ab = b - a;
+    const float lengthSquared = ab.x * ab.x + ab.y * ab.y;
+    float t = lengthSquared > 0.f ? ((p.x - a.x) * ab.x + (p.y - a.y) * ab.y) / lengthSquared : 0.f;
+    t = std::min(1.f, std::max(0.f, t));
+    return EngineMath::Vector2::distance(p, a + ab * t);
+  }
+
+  /**
+   * @brief Writes the collision image of the track: white road along the waypoint loop, black elsewhere.
+   * @return Path of the PNG file.
+   */
+  std::string
+    writeTrackImage(const std::vector<EngineMath::Vector2>& waypoints, uint32_t seed) {
+    const sf::Vector2u size(480, 270);
+    sf::Image image(size, sf::Color::Black);
+    const EngineMath::Vector2 unitsPerPixel(WORLD_SIZE.x / size.x, WORLD_SIZE.y / size.y);
+
+    for (unsigned int y = 0; y < size.y; ++y) {
+      for (unsigned int x = 0; x < size.x; ++x) {
+        const EngineMath::Vector2 world((x + 0.5f) * unitsPerPixel.x, (y + 0.5f) * unitsPerPixel.y);
+        for (size_t i = 0; i < waypoints.size(); ++i) {
+          if (segmentDistance(world, waypoints[i], waypoints[(i + 1) % waypoints.size()]) < ROAD_HALF_WIDTH) {
+            image.setPixel(sf::Vector2u(x, y), sf::Color::White);
+            break;
+          }
+        }
+      }
+    }
+
+    const std::string fileName = (std::filesystem::temp_directory_path() /
+      ("horchata_bench_track_" + std::to_string(seed) + ".png")).string();
+    if (!image.saveToFile(fileName)) {
+      std::cerr << "Can't write the track image: " << fileName << "\n";
+    }
+    return fileName;
+  }
+
+  /**
+   * @brief Builds a scene. The same seed and counts always give the same scene.
+   */
+  Scene
+    generateScene(size_t racerCount, size_t staticCount, int components, uint32_t seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    Scene scene;
+
+    // Closed loop: jittered ellipse around the center of the world
+    const size_t waypointCount = 24;
+    const EngineMath::Vector2 center = WORLD_SIZE * 0.5f;
+    for (size_t i = 0; i < waypointCount; ++i) {
+      const float angle = 6.2831853f * i / waypointCount;
+      const float jitter = 0.9f + 0.2f * unit(random);
+      scene.waypoints.push_back(center + EngineMath::Vector2(std::cos(angle) * 760.f * jitter,
+                                                            std::sin(angle) * 400.f * jitter));
+    }
+    scene.path = EngineUtilities::MakeShared<Path>(scene.waypoints);
+
+    // The track shape (100x50 rectangle) is stretched over the whole world
+    scene.track = EngineUtilities::MakeShared<Actor>("Track Actor");
+    scene.track->getComponent<CShape>()->createShape(ShapeType::RECTANGLE);
+    scene.track->getComponent<Transform>()->setPosition(EngineMath::Vector2(0.f, 0.f));
+    scene.track->getComponent<Transform>()->setScale(EngineMath::Vector2(WORLD_SIZE.x / 100.f, WORLD_SIZE.y / 50.f));
+
+    scene.player = EngineUtilities::MakeShared<APlayer>("Player");
+    scene.player->getComponent<CShape>()->createShape(ShapeType::RECTANGLE);
+    scene.player->getComponent<Transform>()->setPosition(scene.waypoints[0]);
+    scene.player->getComponent<Transform>()->setScale(EngineMath::Vector2(1.f, 2.f) / 3.f);
+    addExtraComponents<0>(*scene.player, components);
+
+    // Racers spread along the loop, on the road, sharing one behavior as in BaseApp
+    EngineUtilities::TSharedPointer<SteeringBehavior> pathFollowing = EngineUtilities::MakeShared<PathFollowing>(scene.path);
+    scene.racers.reserve(racerCount);
+    for (size_t i = 0; i < racerCount; ++i) {
+      const size_t waypoint = static_cast<size_t>(unit(random) * waypointCount) % waypointCount;
+      const EngineMath::Vector2 offset((unit(random) - 0.5f) * ROAD_HALF_WIDTH, (unit(random) - 0.5f) * ROAD_HALF_WIDTH);
+
+      auto racer = EngineUtilities::MakeSharedPooled<ARacer>("Bot " + std::to_string(i + 1));
+      racer->getComponent<CShape>()->createShape(ShapeType::RECTANGLE);
+      racer->getComponent<Transform>()->setPosition(scene.waypoints[waypoint] + offset);
+      racer->getComponent<Transform>()->setScale(EngineMath::Vector2(1.f, 2.f) / 3.f);
+      racer->setCurrentWaypointIndex((waypoint + 1) % waypointCount);
+      racer->addSteeringBehavior(pathFollowing);
+      addExtraComponents<0>(*racer, components);
+      scene.racers.push_back(racer);
+    }
+
+    // Scenery that never moves but is still synced and batched every frame
+    scene.staticActors.reserve(staticCount);
+    for (size_t i = 0; i < staticCount; ++i) {
+      auto actor = EngineUtilities::MakeShared<Actor>("Static " + std::to_string(i + 1));
+      actor->getComponent<CShape>()->createShape(ShapeType::RECTANGLE);
+      actor->getComponent<Transform>()->setPosition(EngineMath::Vector2(unit(random) * WORLD_SIZE.x,
+                                                                        unit(random) * WORLD_SIZE.y));
+      actor->getComponent<Transform>()->setScale(EngineMath::Vector2(0.25f, 0.5f));
+      addExtraComponents<0>(*actor, components);
+      scene.staticActors.push_back(actor);
+    }
+
+    scene.gameManager = EngineUtilities::MakeShared<GameManager>();
+    scene.gameManager->init(scene.track, scene.path, writeTrackImage(scene.waypoints, seed));
+
+    Actor::storePreviousTransforms();
+    return scene;
+  }
+
+  /**
+   * @brief Sums the duration of the zones of the last profiler frame with the given name.
+   */
+  double
+    zoneMicroseconds(const char* name) {
+    double total = 0.0;
+    for (const ProfileZone& zone : Profiler::getInstance().getFrameZones()) {
+      if (std::strcmp(zone.name, name) == 0) {
+        total += (zone.end - zone.start) / 1000.0;
+      }
+    }
+    return total;
+  }
+
+  PhaseStats
+    computeStats(std::vector<double> samples) {
+    PhaseStats stats;
+    if (samples.empty()) {
+      return stats;
+    }
+    std::sort(samples.begin(), samples.end());
+    // Nearest rank
+    auto percentile = [&samples](double p) {
+      size_t rank = static_cast<size_t>(std::ceil(p * samples.size()));
+      return samples[rank > 0 ? rank - 1 : 0];
+    };
+    double sum = 0.0;
+    for (double sample : samples) {
+      sum += sample;
+    }
+    stats.mean = sum / samples.size();
+    stats.min = samples.front();
+    stats.p50 = percentile(0.50);
+    stats.p90 = percentile(0.90);
+    stats.p99 = percentile(0.99);
+    stats.max = samples.back();
+    return stats;
+  }
+
+  /**
+   * @brief Runs one scene size and measures every phase per frame.
+   */
+  ScenarioResult
+    runScenario(size_t racerCount, const Options& options) {
+    const size_t staticCount = options.staticActors < 0 ? racerCount : static_cast<size_t>(options.staticActors);
+    Scene scene = generateScene(racerCount, staticCount, options.components, options.seed);
+
+    SteeringSystem steeringSystem;
+    std::vector<SteeringSystem::NeighborKart> steeringNeighbors;
+    Profiler& profiler = Profiler::getInstance();
+    EngineUtilities::MemoryTracker& memoryTracker = EngineUtilities::MemoryTracker::getInstance();
+    SpriteBatch spriteBatch;
+    const float deltaTime = options.timeStep;
+
+    std::vector<double> samples[PHASE_COUNT];
+    for (auto& phase : samples) {
+      phase.reserve(options.frames);
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto microseconds = [](Clock::time_point start, Clock::time_point end) {
+      return std::chrono::duration<double, std::micro>(end - start).count();
+    };
+
+    const size_t totalFrames = options.warmup + options.frames;
+    for (size_t frame = 0; frame < totalFrames; ++frame) {
+      if (frame == options.warmup) {
+        memoryTracker.resetFrameStats();
+      }
+      profiler.beginFrame();
+
+      // Same order as the systems BaseApp registers, then the render prep
+      const Clock::time_point frameStart = Clock::now();
+      Actor::storePreviousTransforms();
+      for (auto& actor : scene.staticActors) {
+        actor->update(deltaTime);
+      }
+
+      const Clock::time_point gameManagerStart = Clock::now();
+      scene.gameManager->update(deltaTime, scene.racers, scene.player);
+
+      const Clock::time_point steeringStart = Clock::now();
+      steeringNeighbors.clear();
+      steeringNeighbors.push_back(SteeringSystem::NeighborKart{
+        scene.player->getComponent<Transform>()->getPosition(), scene.player->getVelocity() });
+      steeringSystem.update(scene.racers, deltaTime, steeringNeighbors);
+      scene.player->move(deltaTime);
+
+      const Clock::time_point racerCollisionStart = Clock::now();
+      scene.gameManager->resolveRacerCollisions(scene.racers, scene.player);
+
+      const Clock::time_point renderPrepStart = Clock::now();
+      Actor::syncTransforms(1.0f);
+      spriteBatch.begin();
+      scene.track->getComponent<CShape>()->submit(spriteBatch, 0);
+      for (auto& actor : scene.staticActors) {
+        actor->getComponent<CShape>()->submit(spriteBatch, 0);
+      }
+      scene.player->getComponent<CShape>()->submit(spriteBatch, 1);
+      for (auto& racer : scene.racers) {
+        racer->getComponent<CShape>()->submit(spriteBatch, 1);
+      }
+      spriteBatch.flush(EngineUtilities::TSharedPointer<Window>());
+      const Clock::time_point frameEnd = Clock::now();
+
+      EngineUtilities::FrameArena::getInstance().reset();
+      memoryTracker.endFrame();
+      profiler.endFrame();
+
+      if (frame < options.warmup) {
+        continue;
+      }
+      samples[0].push_back(microseconds(frameStart, gameManagerStart));
+      samples[1].push_back(microseconds(steeringStart, racerCollisionStart));
+      samples[2].push_back(microseconds(gameManagerStart, steeringStart));
+      samples[3].push_back(zoneMicroseconds("GameManager::updateProgress"));
+      samples[4].push_back(zoneMicroseconds("GameManager::updateRanks"));
+      samples[5].push_back(zoneMicroseconds("GameManager::checkCollisions"));
+      samples[6].push_back(microseconds(racerCollisionStart, renderPrepStart));
+      samples[7].push_back(microseconds(renderPrepStart, frameEnd));
+      samples[8].push_back(microseconds(frameStart, frameEnd));
+    }
+
+    ScenarioResult result;
+    result.racers = racerCount;
+    result.staticActors = staticCount;
+    for (size_t phase = 0; phase < PHASE_COUNT; ++phase) {
+      result.phases[phase] = computeStats(std::move(samples[phase]));
+    }
+    result.maxFrameAllocations = memoryTracker.getMaxFrameAllocations();
+    result.drawCalls = spriteBatch.getStats().drawCalls;
+    return result;
+  }
+
+  /**
+   * @brief Submits outlined shapes that share one (null) texture and checks that they take one draw call.
+   * @return True if the counters match.
+   */
+  bool
+    checkBatching(size_t shapeCount) {
+    SpriteBatch spriteBatch;
+    sf::RectangleShape shape(sf::Vector2f(30.f, 60.f));
+    shape.setOutlineThickness(2.f);
+    shape.setOutlineColor(sf::Color::Red);
+
+    spriteBatch.begin();
+    for (size_t i = 0; i < shapeCount; ++i) {
+      shape.setPosition(sf::Vector2f(static_cast<float>(i % 64) * 30.f, static_cast<float>(i / 64) * 60.f));
+      spriteBatch.submit(shape, 1);
+    }
+    spriteBatch.flush(EngineUtilities::TSharedPointer<Window>());
+
+    // A rectangle is 2 fill triangles plus 2 triangles per outline edge
+    const RenderStats& stats = spriteBatch.getStats();
+    const size_t expectedVertices = shapeCount * (6 + 4 * 6);
+    const bool batched = stats.drawCalls == 1 && stats.sprites == shapeCount && stats.vertices == expectedVertices;
+    std::cout << "Batching: " << shapeCount << " outlined shapes, " << stats.drawCalls << " draw calls, "
+              << stats.vertices << " vertices" << (batched ? "" : "   FAILED (expected 1 draw call)") << "\n";
+    return batched;
+  }
+
+  /**
+   * @brief Submits outlined shapes alternating between two textures and checks the
+   * draw calls, the vertex count and the texture coordinates of every textured vertex.
+   * The textures are never uploaded: batches are keyed by texture address and the
+   * coordinates come from the texture rect, so no GPU context is needed.
+   * @return True if everything matches.
+   */
+  bool
+    checkTexturedBatching(size_t shapeCount) {
+    const sf::Texture textures[2];
+    const sf::IntRect textureRects[2] = { sf::IntRect({ 0, 0 }, { 32, 64 }), sf::IntRect({ 32, 16 }, { 64, 32 }) };
+    const sf::Vector2f shapeSize(30.f, 60.f);
+    SpriteBatch spriteBatch;
+    sf::RectangleShape shape(shapeSize);
+    shape.setOutlineThickness(2.f);
+
+    std::vector<sf::Vector2f> positions(shapeCount);
+    spriteBatch.begin();
+    for (size_t i = 0; i < shapeCount; ++i) {
+      positions[i] = sf::Vector2f(static_cast<float>(i % 64) * 40.f, static_cast<float>(i / 64) * 70.f);
+      shape.setTexture(&textures[i % 2]);
+      shape.setTextureRect(textureRects[i % 2]);
+      shape.setPosition(positions[i]);
+      spriteBatch.submit(shape, 1);
+    }
+    spriteBatch.flush(EngineUtilities::TSharedPointer<Window>());
+
+    // Every vertex of a textured batch must map its local position onto the rect of its texture
+    size_t badTexCoords = 0;
+    spriteBatch.forEachBatch([&](const sf::Texture* texture, const sf::VertexArray& vertices) {
+      if (!texture) {
+        return;
+      }
+      const size_t first = texture == &textures[0] ? 0 : 1;
+      const sf::IntRect& rect = textureRects[first];
+      for (size_t v = 0; v < vertices.getVertexCount(); ++v) {
+        const size_t shapeIndex = first + 2 * (v / 6);
+        const sf::Vector2f local = vertices[v].position - positions[shapeIndex];
+        const sf::Vector2f expected(rect.position.x + rect.size.x * local.x / shapeSize.x,
+                                    rect.position.y + rect.size.y * local.y / shapeSize.y);
+        const sf::Vector2f error = vertices[v].texCoords - expected;
+        if (std::fabs(error.x) > 1.0e-3f || std::fabs(error.y) > 1.0e-3f) {
+          ++badTexCoords;
+        }
+      }
+    });
+
+    const RenderStats& stats = spriteBatch.getStats();
+    const size_t expectedVertices = shapeCount * (6 + 4 * 6);
+    const bool batched = stats.drawCalls == 3 && stats.sprites == shapeCount &&
+                         stats.vertices == expectedVertices && badTexCoords == 0;
+    std::cout << "Batching: " << shapeCount << " outlined shapes on 2 textures, " << stats.drawCalls
+              << " draw calls, " << stats.vertices << " vertices, " << badTexCoords << " wrong texture coordinates"
+              << (batched ? "" : "   FAILED (expected 3 draw calls and exact texture coordinates)") << "\n";
+    return batched;
+  }
+
+  bool
+    writeJson(const std::string& fileName, const Options& options, const std::vector<ScenarioResult>& results) {
+    std::ofstream output(fileName, std::ios::trunc);
+    if (!output) {
+      return false;
+    }
+    output.setf(std::ios::fixed);
+    output.precision(3);
+    output << "{\n  \"benchmark\": \"SceneBenchmark\",\n"
+           << "  \"label\": \"" << options.label << "\",\n"
+           << "  \"seed\": " << options.seed << ",\n"
+           << "  \"frames\": " << options.frames << ",\n"
+           << "  \"warmup\": " << options.warmup << ",\n"
+           << "  \"timeStep\": " << options.timeStep << ",\n"
+           << "  \"components\": " << options.components << ",\n"
+           << "  \"workers\": " << ThreadPool::getInstance().getWorkerCount() << ",\n"
+           << "  \"unit\": \"us\",\n"
+           << "  \"scenarios\": [";
+    for (size_t s = 0; s < results.size(); ++s) {
+      const ScenarioResult& result = results[s];
+      output << (s == 0 ? "\n" : ",\n")
+             << "    {\"racers\": " << result.racers
+             << ", \"staticActors\": " << result.staticActors
+             << ", \"maxFrameAllocations\": " << result.maxFrameAllocations
+             << ", \"drawCalls\": " << result.drawCalls
+             << ", \"phases\": {";
+      for (size_t phase = 0; phase < PHASE_COUNT; ++phase) {
+        const PhaseStats& stats = result.phases[phase];
+        output << (phase == 0 ? "\n" : ",\n")
+               << "      \"" << PHASES[phase] << "\": {\"mean\": " << stats.mean
+               << ", \"min\": " << stats.min << ", \"p50\": " << stats.p50
+               << ", \"p90\": " << stats.p90 << ", \"p99\": " << stats.p99
+               << ", \"max\": " << stats.max << "}";
+      }
+      output << "\n    }}";
+    }
+    output << "\n  ]\n}\n";
+    return static_cast<bool>(output);
+  }
+
+  bool
+    writeCsv(const std::string& fileName, const Options& options, const std::vector<ScenarioResult>& results) {
+    std::ofstream output(fileName, std::ios::trunc);
+    if (!output) {
+      return false;
+    }
+    output.setf(std::ios::fixed);
+    output.precision(3);
+    output << "label,seed,racers,static_actors,components,phase,mean_us,min_us,p50_us,p90_us,p99_us,max_us\n";
+    for (const ScenarioResult& result : results) {
+      for (size_t phase = 0; phase < PHASE_COUNT; ++phase) {
+        const PhaseStats& stats = result.phases[phase];
+        output << options.label << "," << options.seed << "," << result.racers << ","
+               << result.staticActors << "," << options.components << "," << PHASES[phase] << ","
+               << stats.mean << "," << stats.min << "," << stats.p50 << ","
+               << stats.p90 << "," << stats.p99 << "," << stats.max << "\n";
+      }
+    }
+    return static_cast<bool>(output);
+  }
+}
+
+/**
+ * Usage: SceneBenchmark [--sizes 10,100,1000] [--static N] [--components K]
+ *                       [--frames N] [--warmup N] [--seed S] [--timestep SECONDS]
+ *                       [--label TEXT] [--json FILE] [--csv FILE]
+ */
+int
+main(int argc, char* argv[]) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--sizes") == 0 && hasValue) {
+      options.sizes = parseSizes(argv[++i]);
+    }
+    else if (std::strcmp(argv[i], "--static") == 0 && hasValue) {
+      options.staticActors = std::strtol(argv[++i], nullptr, 10);
+    }
+    else if (std::strcmp(argv[i], "--components") == 0 && hasValue) {
+      options.components = std::min(MAX_EXTRA_COMPONENTS, std::max(0, std::atoi(argv[++i])));
+    }
+    else if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+      options.frames = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+    }
+    else if (std::strcmp(argv[i], "--warmup") == 0 && hasValue) {
+      options.warmup = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+    }
+    else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+      options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    }
+    else if (std::strcmp(argv[i], "--timestep") == 0 && hasValue) {
+      options.timeStep = std::strtof(argv[++i], nullptr);
+    }
+    else if (std::strcmp(argv[i], "--label") == 0 && hasValue) {
+      options.label = argv[++i];
+    }
+    else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+      options.jsonFile = argv[++i];
+    }
+    else if (std::strcmp(argv[i], "--csv") == 0 && hasValue) {
+      options.csvFile = argv[++i];
+    }
+    else {
+      std::cerr << "Unknown option: " << argv[i] << "\n";
+      return 1;
+    }
+  }
+  if (options.frames == 0 || options.timeStep <= 0.f) {
+    std::cerr << "--frames and --timestep must be positive\n";
+    return 1;
+  }
+
+  // Measure the engine, not PNG decoding or cache files
+  AssetCache::getInstance().setEnabled(false);
+
+  bool batched = checkBatching(1000);
+  batched = checkTexturedBatching(1000) && batched;
+  std::vector<ScenarioResult> results;
+  for (size_t size : options.sizes) {
+    results.push_back(runScenario(size, options));
+    const ScenarioResult& result = results.back();
+
+    std::cout << "Scene: " << result.racers << " racers, " << result.staticActors << " static actors, "
+              << options.components << " extra components, " << options.frames << " frames\n";
+    for (size_t phase = 0; phase < PHASE_COUNT; ++phase) {
+      const PhaseStats& stats = result.phases[phase];
+      std::cout << "  " << PHASES[phase] << std::string(16 - std::strlen(PHASES[phase]), ' ')
+                << "p50 " << stats.p50 << " us   p90 " << stats.p90
+                << " us   p99 " << stats.p99 << " us   max " << stats.max << " us\n";
+    }
+    std::cout << "  allocations     " << result.maxFrameAllocations << " max per frame\n";
+    std::cout << "  drawCalls       " << result.drawCalls
+              << (result.drawCalls == SCENE_DRAW_CALLS ? "" : "   FAILED (expected one per layer)") << "\n";
+    batched = batched && result.drawCalls == SCENE_DRAW_CALLS;
+  }
+
+  if (!options.jsonFile.empty() && !writeJson(options.jsonFile, options, results)) {
+    std::cerr << "Can't write " << options.jsonFile << "\n";
+    return 1;
+  }
+  if (!options.csvFile.empty() && !writeCsv(options.csvFile, options, results)) {
+    std::cerr << "Can't write " << options.csvFile << "\n";
+    return 1;
+  }
+  return batched ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file SharedPointerBenchmark.cpp
+ * @brief Copy, move, create and destroy throughput of TSharedPointer (plain and
+ * atomic refcount) against std::shared_ptr.
+ *
+ * Only the Memory headers are used, so it builds without the SFML libraries:
+ *   g++ -std=c++17 -O2 -DNDEBUG -pthread -I include benchmarks/SharedPointerBenchmark.cpp
+ * -DNDEBUG matches a Release build, where the MemoryTracker does not count pointers.
+ * libstdc++ (with glibc 2.32 or later) skips the atomic refcount of std::shared_ptr
+ * while the process has a single thread, so main starts and joins a thread first,
+ * as the engine's ThreadPool does. Otherwise std::shared_ptr would be measured
+ * with plain counters against the atomic MakeSharedAtomic.
+ */
+#include "Memory/TSharedPointer.h"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+  /**
+   * @brief Payload about the size of a small component.
+   */
+  struct Payload {
+    explicit Payload(int v) : value(v) {}
+    int value;
+    float data[7] = {};
+  };
+
+  template<typename Func>
+  double
+    measureNanoseconds(size_t operations, Func&& func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / operations;
+  }
+
+  /**
+   * @brief Runs every test for one pointer type.
+   * @param make Creates a pointer to a new Payload.
+   */
+  template<typename Pointer, typename Make>
+  void
+    runSuite(const char* name, Make&& make) {
+    const size_t count = 100000;
+    const int passes = 50;
+    const size_t operations = count * passes;
+    volatile int sink = 0;
+
+    std::vector<Pointer> sources;
+    sources.reserve(count);
+
+    double create = measureNanoseconds(count, [&]() {
+      for (size_t i = 0; i < count; ++i) {
+        sources.push_back(make(static_cast<int>(i)));
+      }
+    });
+
+    // Copy construction plus destruction of the copy: one increment and one decrement
+    double copy = measureNanoseconds(operations, [&]() {
+      for (int pass = 0; pass < passes; ++pass) {
+        for (size_t i = 0; i < count; ++i) {
+          Pointer copied(sources[i]);
+          sink = sink + copied->value;
+        }
+      }
+    });
+
+    // Rotates the whole vector by one slot, one move per element
+    double move = measureNanoseconds(operations, [&]() {
+      for (int pass = 0; pass < passes; ++pass) {
+        Pointer first(std::move(sources.front()));
+        for (size_t i = 0; i + 1 < count; ++i) {
+          sources[i] = std::move(sources[i + 1]);
+        }
+        sources.back() = std::move(first);
+        sink = sink + sources[pass]->value;
+      }
+    });
+
+    double destroy = measureNanoseconds(count, [&]() {
+      sources.clear();
+    });
+
+    std::cout << "  " << name
+              << "  create: " << create << " ns"
+              << "  copy+release: " << copy << " ns"
+              << "  move: " << move << " ns"
+              << "  destroy: " << destroy << " ns\n";
+  }
+}
+
+int
+main() {
+  // Once a second thread has existed, std::shared_ptr uses atomic counters for good
+  std::thread([]() {}).join();
+
+  std::cout << "Shared pointer throughput, nanoseconds per operation\n";
+
+  runSuite<EngineUtilities::TSharedPointer<Payload>>("TSharedPointer (MakeShared)      ",
+    [](int v) { return EngineUtilities::MakeShared<Payload>(v); });
+
+  runSuite<EngineUtilities::TSharedPointer<Payload>>("TSharedPointer (new T)          ",
+    [](int v) { return EngineUtilities::TSharedPointer<Payload>(new Payload(v)); });
+
+  runSuite<EngineUtilities::TSharedPointer<Payload, EngineUtilities::AtomicRefCount>>(
+    "TSharedPointer (MakeSharedAtomic)",
+    [](int v) { return EngineUtilities::MakeSharedAtomic<Payload>(v); });
+
+  runSuite<std::shared_ptr<Payload>>("std::shared_ptr (make_shared)   ",
+    [](int v) { return std::make_shared<Payload>(v); });
+
+  return 0;
+}
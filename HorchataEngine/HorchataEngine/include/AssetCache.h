@@ -0,0 +1,182 @@
+#pragma once
+#include "Prerequisites.h"
+#include <mutex>
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The pages are loaded by the OS on first touch, so opening a large cached
+ * blob costs no copy until its bytes are used.
+ */
+class
+  MappedFile {
+public:
+  MappedFile() = default;
+
+  /**
+   * @brief Unmaps the file.
+   */
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  /**
+   * @brief Maps a file, unmapping the previous one.
+   * @return False if the file does not exist or could not be mapped.
+   */
+  bool
+    open(const std::string& fileName);
+
+  /**
+   * @brief Unmaps the file.
+   */
+  void
+    close();
+
+  bool
+    isOpen() const {
+    return m_data != nullptr;
+  }
+
+  const uint8_t*
+    data() const {
+    return m_data;
+  }
+
+  size_t
+    size() const {
+    return m_size;
+  }
+
+private:
+  const uint8_t* m_data = nullptr;
+  size_t m_size = 0;
+#if defined(_WIN32)
+  void* m_fileHandle = nullptr;
+  void* m_mappingHandle = nullptr;
+#endif
+};
+
+/**
+ * @class AssetCache
+ * @brief Disk cache of preprocessed asset data, keyed by the content hash of the source.
+ *
+ * Each entry is a small header plus a raw payload (RGBA pixels, collision masks,
+ * ...) stored as Cache/<hash>.<kind>. A lookup hashes the source file and maps
+ * the entry, so a warm start reads raw bytes instead of decoding PNGs. Editing
+ * a source changes its hash and the stale entry is simply not used again.
+ * Safe to call from ThreadPool jobs.
+ */
+class
+  AssetCache {
+private:
+  AssetCache() = default;
+  ~AssetCache() = default;
+
+public:
+  AssetCache(const AssetCache&) = delete;
+  AssetCache& operator=(const AssetCache&) = delete;
+
+  /**
+   * @brief Gets the global cache.
+   */
+  static AssetCache&
+    getInstance() {
+    static AssetCache instance;
+    return instance;
+  }
+
+  /**
+   * @brief Sets the folder the entries are stored in (default "Cache").
+   */
+  void
+    setDirectory(const std::string& directory);
+
+  /**
+   * @brief Gets the folder the entries are stored in. Other disk caches (atlas pages) live there too.
+   */
+  std::string
+    getDirectory();
+
+  /**
+   * @brief Enables or disables the cache. Disabled lookups always miss and nothing is written.
+   */
+  void
+    setEnabled(bool enabled) {
+    m_enabled = enabled;
+  }
+
+  /**
+   * @brief Hashes the content of a file (64-bit, xxHash64-style mixing).
+   * Results are remembered per path until the size or modification time of the file changes.
+   * @return The hash, or 0 if the file can't be read.
+   */
+  uint64_t
+    hashFile(const std::string& fileName);
+
+  /**
+   * @brief Maps the entry of a kind derived from a source file.
+   * @param sourceFile File the data was derived from.
+   * @param kind Name of the derived data, part of the file name ("rgba", "mask", ...).
+   * @param file Receives the mapping of the whole entry.
+   * @param payload Receives the start of the payload inside the mapping.
+   * @param payloadSize Receives the payload size in bytes.
+   * @return False on a miss (no entry, other source content or bad header).
+   */
+  bool
+    find(const std::string& sourceFile,
+         const std::string& kind,
+         MappedFile& file,
+         const uint8_t*& payload,
+         size_t& payloadSize);
+
+  /**
+   * @brief Writes the entry of a kind derived from a source file.
+   * The file is written under a temporary name and renamed, so readers never see half of it.
+   * @return True if the entry was written.
+   */
+  bool
+    store(const std::string& sourceFile, const std::string& kind, const void* payload, size_t payloadSize);
+
+  /**
+   * @brief Loads an image through the cache: raw RGBA pixels on a hit, PNG decode (and store) on a miss.
+   * @return False if the image can't be loaded at all.
+   */
+  bool
+    loadImage(const std::string& sourceFile, sf::Image& image);
+
+private:
+  /**
+   * @brief Header at the start of every entry.
+   */
+  struct EntryHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceHash;
+    uint64_t payloadSize;
+  };
+
+  /**
+   * @brief Builds the path of the entry for a source hash and kind.
+   */
+  std::string
+    entryPath(uint64_t sourceHash, const std::string& kind) const;
+
+  /**
+   * @brief Remembered hash of a source, valid while its size and modification time match.
+   */
+  struct HashEntry {
+    uint64_t size;
+    int64_t modifiedTime;
+    uint64_t hash;
+  };
+
+  std::mutex m_mutex;
+  std::string m_directory = "Cache";
+  std::atomic<bool> m_enabled{ true };
+  std::unordered_map<std::string, HashEntry> m_hashes; /**< Content hash of every source seen. */
+};
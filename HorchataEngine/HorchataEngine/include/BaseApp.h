@@ -8,6 +8,9 @@
 #include "EngineGUI.h"
 #include "GameManager.h"
 #include "SteeringBehaviors.h"
+#include "ECS/SystemScheduler.h"
+#include "ECS/SteeringSystem.h"
+#include "SpriteBatch.h"
 
 /**
  * @class BaseApp
@@ -36,6 +39,16 @@ public:
   int
     run();
 
+  /**
+   * @brief Runs the simulation without window or GUI, with a fixed timestep.
+   * Frames are stepped back to back, as fast as the CPU allows.
+   * @param frameCount Number of fixed steps to simulate.
+   * @param fixedDeltaTime Duration of one step in seconds.
+   * @return Application exit status code.
+   */
+  int
+    runHeadless(size_t frameCount, float fixedDeltaTime = 1.f / 120.f);
+
   /**
    * @brief Initializes the application resources and window.
    * @return True if initialization is successful, false otherwise.
@@ -62,6 +75,27 @@ public:
     destroy();
 
 private:
+  /**
+   * @brief Creates the actors, the game manager and the systems.
+   * Textures are skipped when running headless.
+   * @return True if every actor was created.
+   */
+  bool
+    initScene();
+
+  /**
+   * @brief Registers the per-frame systems in the scheduler.
+   */
+  void
+    registerSystems();
+
+  /**
+   * @brief Advances the simulation by one fixed step.
+   * @param deltaTime Duration of the step in seconds.
+   */
+  void
+    stepSimulation(float deltaTime);
+
 	std::vector<EngineUtilities::TSharedPointer<Actor>> m_actors; /**< Vector of actors in the scene. */
 	
   EngineUtilities::TSharedPointer<Window> m_windowPtr;
@@ -71,7 +105,15 @@ private:
 	std::vector<EngineUtilities::TSharedPointer<ARacer>> m_Aracers; /**< Vector of AI racers in the game. */
 
 	EngineUtilities::TSharedPointer<GameManager> m_gameManager; /**< Pointer to the GameManager for high-level game logic. */
-  std::vector<EngineMath::Vector2> m_waypoints;
+	EngineUtilities::TSharedPointer<Path> m_path; /**< Racing line shared by the GameManager and every racer. */
 
 	EngineGUI m_engineGUI; /**< Instance of the EngineGUI for rendering ImGui elements. */
+	SpriteBatch m_spriteBatch; /**< Gathers the actor shapes into one draw call per texture. */
+	SystemScheduler m_scheduler{ ThreadPool::getInstance() }; /**< Runs the gameplay systems every frame. */
+	SteeringSystem m_steeringSystem; /**< Steers the racers in batches. */
+	std::vector<SteeringSystem::NeighborKart> m_steeringNeighbors; /**< Player kart as seen by the racers' neighbour behaviors. */
+	bool m_headless = false; /**< True when running without window, GUI or textures. */
+	float m_fixedDeltaTime = 1.f / 120.f; /**< Duration of one simulation step, independent of the frame rate. */
+	float m_maxFrameTime = 0.25f; /**< Longest frame time fed to the accumulator. */
+	float m_accumulator = 0.f; /**< Frame time not yet simulated. */
 };
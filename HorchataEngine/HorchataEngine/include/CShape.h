@@ -1,9 +1,10 @@
 #pragma once
 #include "Prerequisites.h"
-#include "ECS\Component.h"
-#include "ECS\Texture.h"
+#include "ECS/Component.h"
+#include "ECS/Texture.h"
 
 class Window;
+class SpriteBatch;
 //class Texture;
 
 /**
@@ -60,6 +61,14 @@ public:
   void
     render(const EngineUtilities::TSharedPointer<Window>& window) override;
 
+  /**
+   * @brief Adds the shape to a sprite batch instead of drawing it right away.
+   * @param spriteBatch The batch that gathers the shape.
+   * @param layer Draw layer, lower layers are drawn first.
+   */
+  void
+    submit(SpriteBatch& spriteBatch, int layer = 0) const;
+
 	void 
     destroy() override;
 
@@ -102,9 +111,40 @@ public:
   void
     setTexture(const EngineUtilities::TSharedPointer<Texture>& texture);
 
+  /**
+   * @brief Sets a part of a texture, such as a sprite of an atlas page.
+   * @param region Texture and pixel rectangle to show; an empty rect uses the whole texture.
+   */
+  void
+    setTexture(const TextureRegion& region);
+
+  /**
+   * @brief Gets the bounds of the shape before its transform is applied.
+   */
+  sf::FloatRect
+    getLocalBounds() const;
+
 private:
+  /**
+   * @brief Rebinds the texture when new pixels were uploaded to it (async loads),
+   * so the texture rect follows the real image size instead of the placeholder,
+   * and marks it as used in the ResourceManager.
+   */
+  void
+    refreshTexture() const;
+
 	EngineUtilities::TSharedPointer<sf::Shape> m_shapePtr; /**< Shared pointer to the SFML shape. */
   //sf::Shape* m_shape;  /**< Pointer to the SFML shape.*/
   ShapeType m_shapeType;  /**< Type of the shape.*/
   sf::VertexArray* m_line;  /**< Optional line representation (if any).*/
+  EngineUtilities::TSharedPointer<Texture> m_texture;  /**< Texture bound to the shape.*/
+  mutable uint32_t m_textureRevision = 0;  /**< Revision of m_texture the shape was bound to.*/
+  sf::IntRect m_textureRect;  /**< Region of m_texture shown, empty for the whole texture.*/
+  TextureHandle m_textureHandle;  /**< Entry of m_texture in the ResourceManager, touched on every draw.*/
 };
+
+/**
+ * @brief Shapes live by value in the Registry, next to the Transform they mirror.
+ */
+template<>
+struct IsDenseComponent<CShape> : std::true_type {};
@@ -31,12 +31,27 @@ public:
 		update(float deltaTime) override;
 
 	/**
-	 * @brief Handles player input and updates movement.
+	 * @brief Reads the keyboard and updates the player's velocity.
+	 * Touches no component, so it can run next to systems that move other actors.
 	 * @param deltaTime Time elapsed since the last update.
 	 */
 	void
 		handleInput(float deltaTime);
 
+	/**
+	 * @brief Moves the player's Transform with the current velocity.
+	 * @param deltaTime Time elapsed since the last update.
+	 */
+	void
+		move(float deltaTime);
+
+	/**
+	 * @brief Gets the current velocity of the player.
+	 * @return The velocity vector.
+	 */
+	const EngineMath::Vector2&
+		getVelocity() const;
+
 	/**
 	 * @brief Sets the current waypoint index for the player.
 	 * @param index The waypoint index to set.
@@ -78,7 +93,7 @@ private:
 	float m_acceleration = 500.f;
 
 	/**
-	 * @brief Friction applied to the player's movement.
+	 * @brief Friction applied to the player's movement, as the velocity factor kept every 1/60 s.
 	 */
 	float m_friction = 0.98f;
 
@@ -48,9 +48,28 @@ public:
 	/**
 	 * @brief Adds a steering behavior to the racer.
 	 * @param behavior Shared pointer to the steering behavior to add.
+	 * @param weight Scale of its force among the behaviors of the same priority.
+	 * @param priority Higher priorities take the force budget first, see SteeringCombiner.
 	 */
 	void
-		addSteeringBehavior(EngineUtilities::TSharedPointer<SteeringBehavior> behavior);
+		addSteeringBehavior(EngineUtilities::TSharedPointer<SteeringBehavior> behavior, float weight = 1.f, int priority = 0);
+
+	/**
+	 * @brief Gets the steering behaviors of the racer, highest priority first.
+	 */
+	const std::vector<WeightedSteering>&
+		getSteeringBehaviors() const {
+		return m_weightedSteering;
+	}
+
+	/**
+	 * @brief Gets a counter that changes every time the steering behaviors change.
+	 * Lets SteeringSystem regroup the racers only when needed.
+	 */
+	uint32_t
+		getSteeringVersion() const {
+		return m_steeringVersion;
+	}
 
 	/**
 	 * @brief Sets the next waypoint for the racer.
@@ -94,6 +113,36 @@ public:
 	float
 		getMaxSpeed() const;
 
+	/**
+	 * @brief Sets the force budget the steering behaviors of the racer share.
+	 * Until it is called, or after a negative value, the budget follows the max speed, see getMaxForce.
+	 * @param maxForce The maximum steering force.
+	 */
+	void
+		setMaxForce(float maxForce);
+
+	/**
+	 * @brief Gets the force budget the steering behaviors of the racer share.
+	 * @return The value given to setMaxForce, or twice the max speed if none was
+	 * given, so a single behavior can always reverse the velocity.
+	 */
+	float
+		getMaxForce() const;
+
+	/**
+	 * @brief Sets how far along the path the racer is, see GameManager::getProgress.
+	 * @param distance Arc length from the first waypoint, within the current lap.
+	 */
+	void
+		setPathDistance(float distance);
+
+	/**
+	 * @brief Gets how far along the path the racer is.
+	 * @return Arc length from the first waypoint, within the current lap.
+	 */
+	float
+		getPathDistance() const;
+
 	/**
 	 * @brief Sets the current waypoint index for the racer.
 	 * @param index The waypoint index to set.
@@ -134,6 +183,11 @@ private:
 	 */
 	size_t m_currentWaypointIndex = 0;
 
+	/**
+	 * @brief Arc length along the path within the current lap.
+	 */
+	float m_pathDistance = 0.f;
+
 	/**
 	 * @brief The position of the next waypoint.
 	 */
@@ -144,6 +198,11 @@ private:
 	 */
 	float m_maxSpeed = 250.f;
 
+	/**
+	 * @brief The maximum steering force set with setMaxForce, negative to follow the max speed.
+	 */
+	float m_maxForce = -1.f;
+
 	/**
 	 * @brief The current velocity of the racer.
 	 */
@@ -155,7 +214,18 @@ private:
 	int m_lapCount = 0;
 
 	/**
-	 * @brief List of steering behaviors applied to the racer.
+	 * @brief Keeps the steering behaviors of the racer alive. Only for ownership:
+	 * m_weightedSteering holds raw pointers to them and is what the steering code reads.
 	 */
 	std::vector<EngineUtilities::TSharedPointer<SteeringBehavior>> m_steeringBehaviors;
+
+	/**
+	 * @brief The same behaviors with their weight and priority, sorted for SteeringCombiner.
+	 */
+	std::vector<WeightedSteering> m_weightedSteering;
+
+	/**
+	 * @brief Incremented by every change of m_weightedSteering.
+	 */
+	uint32_t m_steeringVersion = 0;
 };
\ No newline at end of file
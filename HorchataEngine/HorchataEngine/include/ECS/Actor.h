@@ -1,8 +1,9 @@
 #pragma once
 #include "../Prerequisites.h"
 #include "Entity.h"
-#include "Cshape.h"
+#include "../CShape.h"
 #include "Transform.h"
+#include "../Threading/ThreadPool.h"
 
 class 
 Actor : Entity
@@ -33,7 +34,8 @@ public:
 	beginplay() override {};
 
 	/**
-	 * @brief Updates the actor's components.
+	 * @brief Updates the actor.
+	 * Transform to shape sync runs as a single Registry pass, see syncTransforms.
 	 * @param deltaTime Time since the last frame.
 	 */
 	void
@@ -52,21 +54,61 @@ public:
 	void
 	destroy() override {};
 
+	/**
+	 * @brief Copies every Transform into its CShape, streaming the dense columns.
+	 * Large archetypes are split across the ThreadPool.
+	 * @param alpha Blend between the previous (0) and current (1) simulation step.
+	 */
+	static void
+	syncTransforms(float alpha = 1.0f);
+
+	/**
+	 * @brief Saves the state of every Transform before a fixed simulation step.
+	 */
+	static void
+	storePreviousTransforms();
+
 	void
 	setTexture(const EngineUtilities::TSharedPointer<Texture>& texture);
 
-	std::string getName() { 
-		return m_name; 
+	/**
+	 * @brief Shows a part of a texture, e.g. a sprite packed in an atlas page.
+	 * @param region Texture and pixel rectangle, see ResourceManager::getTextureRegion.
+	 */
+	void
+	setTexture(const TextureRegion& region);
+
+	/**
+	 * @brief Shows a whole texture of the ResourceManager, see ResourceManager::acquireTexture.
+	 * @param handle Handle of the texture; an evicted or invalid handle is ignored.
+	 */
+	void
+	setTexture(TextureHandle handle);
+
+	/**
+	 * @brief Gets the name of the actor, without copying it.
+	 */
+	const std::string&
+	getName() const {
+		return m_name;
 	}
 
 	/**
-	 * @brief Adds a component to the actor.
-	 * @param component The component to add.
+	 * @brief Gets a component of the specified type from the actor.
+	 * @return A pointer to the component, or an empty pointer if not found.
 	 */
 	template <typename T>
-	EngineUtilities::TSharedPointer<T>
+	ComponentPointer<T>
 	getComponent();
 
+	/**
+	 * @brief Gets the id of the actor in the Registry.
+	 */
+	EntityID
+	getEntityID() const {
+		return Entity::getEntityID();
+	}
+
 
 private:
 	/**
@@ -76,17 +118,11 @@ private:
 };
 
 /**
- * @brief Adds a component to the actor.
- * @param component The component to add.
+ * @brief Gets a component of the specified type from the actor.
+ * @return A pointer to the component (see Entity::getComponent), or an empty pointer if not found.
  */
 template <typename T>
-inline EngineUtilities::TSharedPointer<T>
+inline ComponentPointer<T>
 Actor::getComponent() {
-	for (auto& component : components) {
-		EngineUtilities::TSharedPointer<T> specificComponent = component.template dynamic_pointer_cast<T>();
-		if (specificComponent) {
-			return specificComponent;
-		}
-	}
-	return EngineUtilities::TSharedPointer<T>();
+	return Entity::getComponent<T>();
 }
\ No newline at end of file
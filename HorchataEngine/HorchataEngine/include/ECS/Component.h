@@ -15,6 +15,14 @@ enum
 	TEXTURE = 7
 };
 
+/**
+ * @brief Marks component types that the Registry stores by value in archetype columns.
+ * Specialize it to std::true_type next to the component declaration. Components that
+ * are shared between entities (e.g. Texture) keep the default and stay referenced.
+ */
+template<typename T>
+struct IsDenseComponent : std::false_type {};
+
 class 
 	Component {
 public:
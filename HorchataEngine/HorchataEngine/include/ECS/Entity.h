@@ -1,17 +1,36 @@
 #pragma once
 #include "../Prerequisites.h"
 #include "Component.h"
+#include "Registry.h"
 
 class Window;
 
+/**
+ * @brief What Entity::getComponent returns for T.
+ * Dense components get a plain pointer into their Registry column, which owns
+ * them; referenced components get an owning pointer.
+ */
+template<typename T>
+using ComponentPointer = std::conditional_t<IsDenseComponent<T>::value, T*, EngineUtilities::TSharedPointer<T>>;
+
 class 
 Entity {
 public:
 	/**
 	 * @brief Default constructor for the entity.
+	 * Registers the entity in the Registry, which owns its dense components.
+	 */
+	Entity() : isActive(true), id(Registry::getInstance().create()) {}
+
+	Entity(const Entity&) = delete;
+	Entity& operator=(const Entity&) = delete;
+
+	/**
+	 * @brief Destructor for the entity.
+	 * Releases the entity and its dense components from the Registry.
 	 */
 	virtual 
-		~Entity() = default; // Virtual destructor for proper cleanup
+		~Entity() { Registry::getInstance().destroy(id); }
 
 	/*
 	* @brief Begin play function for the entity.
@@ -42,31 +61,76 @@ public:
 		destroy() = 0; // Pure virtual function for cleanup
 
 	/**
-	* @brief Adds a component to the entity.
+	* @brief Adds a referenced component to the entity, which shares it.
+	* Dense components live in the Registry; create them with emplaceComponent.
 	* @param component The component to add.
 	*/
 	template <typename T>
 	void 
 		addComponent(EngineUtilities::TSharedPointer<T> component) {
 		static_assert(std::is_base_of<Component, T>::value, "T must be derived from Component");
-		components.push_back(component.template dynamic_pointer_cast<Component>());
+		static_assert(!IsDenseComponent<T>::value,
+		              "Dense components are stored in the Registry, use emplaceComponent<T>(...)");
+		const ComponentTypeID typeID = getComponentTypeID<T>();
+		if (typeID == INVALID_INDEX) {
+			return;
+		}
+		const ComponentMask bit = ComponentMask(1) << typeID;
+		if (m_componentMask & bit) {
+			components[m_componentSlots[typeID]] = EngineUtilities::TSharedPointer<Component>(component);
+			return;
+		}
+		m_componentSlots[typeID] = static_cast<uint8_t>(components.size());
+		m_componentMask |= bit;
+		components.push_back(EngineUtilities::TSharedPointer<Component>(component));
+	}
+
+	/**
+	* @brief Constructs a dense component directly inside the Registry.
+	* @param args Arguments forwarded to the component constructor.
+	* @return Pointer to the stored component, or nullptr if T got no ComponentTypeID.
+	*/
+	template <typename T, typename... Args>
+	T*
+		emplaceComponent(Args&&... args) {
+		static_assert(std::is_base_of<Component, T>::value, "T must be derived from Component");
+		static_assert(IsDenseComponent<T>::value, "T must be a dense component");
+		return Registry::getInstance().emplace<T>(id, std::forward<Args>(args)...);
 	}
 
 	/**
 	* @brief Gets a component of the specified type from the entity.
-	* @return A shared pointer to the component, or an empty pointer if not found.
+	* Lookup is by exact type and costs one indexed load, no RTTI involved.
+	*
+	* Dense components (IsDenseComponent) come back as a raw pointer into their
+	* Registry column. It is invalidated by the next structural change of the
+	* Registry (create, destroy, emplace of a new type or remove), so use it within
+	* the current call and fetch it again later.
+	* Referenced components are returned as owning pointers.
+	* @return A pointer to the component, or an empty pointer if not found.
 	*/
 	template <typename T>
-	EngineUtilities::TSharedPointer<T> 
+	ComponentPointer<T>
 	getComponent() {
-		for(auto& component : components) {
-			EngineUtilities::TSharedPointer<T> specificComponent = component.template dynamic_pointer_cast<T>();
-			if(specificComponent) {
-				return specificComponent;
+		if constexpr (IsDenseComponent<T>::value) {
+			return Registry::getInstance().tryGet<T>(id);
+		}
+		else {
+			const ComponentTypeID typeID = getComponentTypeID<T>();
+			if (typeID == INVALID_INDEX || !(m_componentMask & (ComponentMask(1) << typeID))) {
+				return EngineUtilities::TSharedPointer<T>();
 			}
+			const EngineUtilities::TSharedPointer<Component>& component = components[m_componentSlots[typeID]];
+			return EngineUtilities::TSharedPointer<T>(static_cast<T*>(component.get()), component.controlBlock);
 		}
+	}
 
-		return EngineUtilities::TSharedPointer<T>();
+	/**
+	* @brief Gets the id of the entity in the Registry.
+	*/
+	EntityID
+		getEntityID() const {
+		return id;
 	}
 
 protected:
@@ -79,7 +143,15 @@ protected:
 	 */
 	uint32_t id;
 	/**
-	 * @brief List of components associated with the entity.
+	 * @brief List of referenced (non-dense) components associated with the entity.
 	 */
 	std::vector<EngineUtilities::TSharedPointer<Component>> components;
+	/**
+	 * @brief Bit per ComponentTypeID of the referenced components the entity owns.
+	 */
+	ComponentMask m_componentMask = 0;
+	/**
+	 * @brief Index in components of each referenced component, by ComponentTypeID.
+	 */
+	uint8_t m_componentSlots[MAX_COMPONENT_TYPES] = {};
 };
\ No newline at end of file
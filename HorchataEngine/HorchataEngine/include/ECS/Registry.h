@@ -0,0 +1,437 @@
+#pragma once
+#include "../Prerequisites.h"
+
+/**
+ * @brief Identifier of an entity stored in the Registry.
+ */
+using EntityID = uint32_t;
+
+/**
+ * @brief Index assigned to every component type the Registry stores by value.
+ */
+using ComponentTypeID = uint32_t;
+
+/**
+ * @brief Bitmask with one bit per ComponentTypeID, used as archetype signature.
+ */
+using ComponentMask = uint64_t;
+
+/**
+ * @brief Maximum number of dense component types (one bit of ComponentMask each).
+ */
+constexpr ComponentTypeID MAX_COMPONENT_TYPES = 64;
+
+/**
+ * @brief Value returned when an entity or archetype could not be resolved.
+ */
+constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+/**
+ * @brief Hands out the next free component type index.
+ * Past MAX_COMPONENT_TYPES masks have no bit left: the type is reported and gets
+ * INVALID_INDEX, which the Registry and Entity treat as a component nobody has.
+ * @param typeName Name of the type, for the report.
+ * @return A new, unique ComponentTypeID, or INVALID_INDEX.
+ */
+inline ComponentTypeID
+nextComponentTypeID(const std::string& typeName) {
+	static std::atomic<ComponentTypeID> counter{ 0 };
+	const ComponentTypeID id = counter.fetch_add(1);
+	if (id >= MAX_COMPONENT_TYPES) {
+		std::cerr << "[Registry] More than " << MAX_COMPONENT_TYPES << " component types, " << typeName
+		          << " can't be stored. Raise MAX_COMPONENT_TYPES and ComponentMask.\n";
+		return INVALID_INDEX;
+	}
+	return id;
+}
+
+/**
+ * @brief Gets the type index of a component type.
+ * The index is assigned the first time the type is queried and never changes.
+ * @return The ComponentTypeID of T, or INVALID_INDEX if there were no ids left.
+ */
+template<typename T>
+inline ComponentTypeID
+getComponentTypeID() {
+	static const ComponentTypeID id = nextComponentTypeID(EngineUtilities::MemoryTracker::typeName<T>());
+	return id;
+}
+
+/**
+ * @brief Checks that every type in Ts got a ComponentTypeID.
+ */
+template<typename... Ts>
+inline bool
+hasComponentTypeIDs() {
+	return ((getComponentTypeID<Ts>() != INVALID_INDEX) && ...);
+}
+
+/**
+ * @brief Builds the mask with the bits of every type in Ts.
+ * Types without a ComponentTypeID add no bit; check hasComponentTypeIDs first.
+ */
+template<typename... Ts>
+inline ComponentMask
+componentMask() {
+	return (ComponentMask(0) | ... |
+	        (getComponentTypeID<Ts>() != INVALID_INDEX ? ComponentMask(1) << getComponentTypeID<Ts>() : ComponentMask(0)));
+}
+
+/**
+ * @class IComponentColumn
+ * @brief Type-erased column of an archetype (one dense array per component type).
+ */
+class
+	IComponentColumn {
+public:
+	virtual
+		~IComponentColumn() = default;
+
+	/**
+	 * @brief Creates an empty column that stores the same component type.
+	 */
+	virtual EngineUtilities::TUniquePtr<IComponentColumn>
+		createEmpty() const = 0;
+
+	/**
+	 * @brief Moves the element at row to the end of another column of the same type.
+	 * The source slot is left in a moved-from state until removeRow is called.
+	 */
+	virtual void
+		moveElementTo(size_t row, IComponentColumn& destination) = 0;
+
+	/**
+	 * @brief Removes the element at row by moving the last element into its place.
+	 */
+	virtual void
+		removeRow(size_t row) = 0;
+
+	/**
+	 * @brief Gets the number of components stored.
+	 */
+	virtual size_t
+		size() const = 0;
+
+	/**
+	 * @brief Gets the bytes reserved by the column storage.
+	 */
+	virtual size_t
+		capacityBytes() const = 0;
+
+	/**
+	 * @brief Gets the MemoryTracker slot the column type reports to.
+	 */
+	virtual uint32_t
+		memorySlot() const = 0;
+};
+
+/**
+ * @class ComponentColumn
+ * @brief Contiguous storage for every component of type T inside one archetype.
+ */
+template<typename T>
+class
+	ComponentColumn : public IComponentColumn {
+public:
+	EngineUtilities::TUniquePtr<IComponentColumn>
+		createEmpty() const override {
+		return EngineUtilities::MakeUnique<ComponentColumn<T>>();
+	}
+
+	void
+		moveElementTo(size_t row, IComponentColumn& destination) override {
+		static_cast<ComponentColumn<T>&>(destination).data.push_back(std::move(data[row]));
+	}
+
+	void
+		removeRow(size_t row) override {
+		if (row + 1 != data.size()) {
+			data[row] = std::move(data.back());
+		}
+		data.pop_back();
+	}
+
+	size_t
+		size() const override {
+		return data.size();
+	}
+
+	size_t
+		capacityBytes() const override {
+		return data.capacity() * sizeof(T);
+	}
+
+	uint32_t
+		memorySlot() const override {
+		static const uint32_t slot = EngineUtilities::MemoryTracker::getInstance().registerName(
+			EngineUtilities::MemoryTracker::typeName<T>() + " (Registry)");
+		return slot;
+	}
+
+	std::vector<T> data; /**< Component values, one per entity row. */
+};
+
+/**
+ * @class Archetype
+ * @brief Group of entities that own exactly the same set of dense components.
+ *
+ * Row i of every column belongs to entities[i], so a system that needs several
+ * components walks the columns in lockstep without any pointer chasing.
+ */
+class
+	Archetype {
+public:
+	/**
+	 * @brief Gets the typed column for T. The archetype must contain T.
+	 */
+	template<typename T>
+	ComponentColumn<T>&
+		getColumn() {
+		return *static_cast<ComponentColumn<T>*>(columns[getComponentTypeID<T>()].get());
+	}
+
+	ComponentMask mask = 0; /**< Signature of the archetype. */
+	std::vector<EntityID> entities; /**< Entity stored in each row. */
+	EngineUtilities::TUniquePtr<IComponentColumn> columns[MAX_COMPONENT_TYPES]; /**< Columns indexed by ComponentTypeID. */
+};
+
+/**
+ * @class Registry
+ * @brief Owns the dense component storage of every entity, grouped by archetype.
+ *
+ * Entity::addComponent / getComponent sit on top of it for component types marked
+ * with IsDenseComponent. Systems use each() / eachChunk() to stream the columns.
+ * References and pointers to components stay valid until the next structural
+ * change (create, destroy, emplace of a new type or remove) in the Registry.
+ */
+class
+	Registry {
+private:
+	Registry();
+	~Registry() = default;
+
+public:
+	Registry(const Registry&) = delete;
+	Registry& operator=(const Registry&) = delete;
+
+	/**
+	 * @brief Gets the global registry.
+	 */
+	static Registry&
+		getInstance() {
+		static Registry instance;
+		return instance;
+	}
+
+	/**
+	 * @brief Creates an entity without components.
+	 * @return The id of the new entity.
+	 */
+	EntityID
+		create();
+
+	/**
+	 * @brief Destroys an entity and all of its dense components.
+	 * @param entity The entity to destroy.
+	 */
+	void
+		destroy(EntityID entity);
+
+	/**
+	 * @brief Checks if an entity id refers to a live entity.
+	 */
+	bool
+		isAlive(EntityID entity) const {
+		return entity < m_records.size() && m_records[entity].alive;
+	}
+
+	/**
+	 * @brief Constructs (or replaces) a component of type T for an entity.
+	 * Adding a new type moves the entity to the archetype with that extra column.
+	 * @return Pointer to the stored component, or nullptr if T got no ComponentTypeID.
+	 */
+	template<typename T, typename... Args>
+	T*
+		emplace(EntityID entity, Args&&... args) {
+		const ComponentTypeID typeID = getComponentTypeID<T>();
+		if (typeID == INVALID_INDEX) {
+			return nullptr;
+		}
+		const ComponentMask bit = ComponentMask(1) << typeID;
+		EntityRecord& record = m_records[entity];
+		Archetype& current = *m_archetypes[record.archetype];
+
+		if (current.mask & bit) {
+			T& slot = current.getColumn<T>().data[record.row];
+			slot = T(std::forward<Args>(args)...);
+			return &slot;
+		}
+
+		uint32_t target = findArchetype(current.mask | bit);
+		if (target == INVALID_INDEX) {
+			target = createArchetype(current.mask | bit, current,
+			                         EngineUtilities::MakeUnique<ComponentColumn<T>>(), typeID);
+		}
+		moveEntity(entity, target);
+
+		std::vector<T>& data = m_archetypes[target]->getColumn<T>().data;
+		data.emplace_back(std::forward<Args>(args)...);
+		return &data.back();
+	}
+
+	/**
+	 * @brief Removes the component of type T from an entity, if present.
+	 */
+	template<typename T>
+	void
+		remove(EntityID entity) {
+		const ComponentTypeID typeID = getComponentTypeID<T>();
+		if (typeID == INVALID_INDEX) {
+			return;
+		}
+		const ComponentMask bit = ComponentMask(1) << typeID;
+		EntityRecord& record = m_records[entity];
+		Archetype& current = *m_archetypes[record.archetype];
+		if (!(current.mask & bit)) {
+			return;
+		}
+
+		uint32_t target = findArchetype(current.mask & ~bit);
+		if (target == INVALID_INDEX) {
+			target = createArchetype(current.mask & ~bit, current,
+			                         EngineUtilities::TUniquePtr<IComponentColumn>(), INVALID_INDEX);
+		}
+		moveEntity(entity, target);
+	}
+
+	/**
+	 * @brief Gets the component of type T of an entity.
+	 * @return Pointer to the component, or nullptr if the entity does not have it.
+	 */
+	template<typename T>
+	T*
+		tryGet(EntityID entity) {
+		const ComponentTypeID typeID = getComponentTypeID<T>();
+		if (!isAlive(entity) || typeID == INVALID_INDEX) {
+			return nullptr;
+		}
+		const EntityRecord& record = m_records[entity];
+		IComponentColumn* column = m_archetypes[record.archetype]->columns[typeID].get();
+		if (!column) {
+			return nullptr;
+		}
+		return &static_cast<ComponentColumn<T>*>(column)->data[record.row];
+	}
+
+	/**
+	 * @brief Checks if an entity has a component of type T.
+	 */
+	template<typename T>
+	bool
+		has(EntityID entity) {
+		return tryGet<T>(entity) != nullptr;
+	}
+
+	/**
+	 * @brief Calls func(EntityID, Ts&...) for every entity that owns all of Ts.
+	 * Rows are visited archetype by archetype, in column order.
+	 */
+	template<typename... Ts, typename Func>
+	void
+		each(Func&& func) {
+		eachChunk<Ts...>([&func](size_t count, const EntityID* entities, Ts*... columns) {
+			for (size_t row = 0; row < count; ++row) {
+				func(entities[row], columns[row]...);
+			}
+		});
+	}
+
+	/**
+	 * @brief Calls func(count, const EntityID*, Ts*...) once per matching archetype.
+	 * The pointers address the raw, contiguous columns so systems can run tight
+	 * (or vectorized) loops over them.
+	 */
+	template<typename... Ts, typename Func>
+	void
+		eachChunk(Func&& func) {
+		if (!hasComponentTypeIDs<Ts...>()) {
+			return;
+		}
+		const ComponentMask required = componentMask<Ts...>();
+		for (auto& archetype : m_archetypes) {
+			if ((archetype->mask & required) != required || archetype->entities.empty()) {
+				continue;
+			}
+			func(archetype->entities.size(), archetype->entities.data(),
+			     archetype->getColumn<Ts>().data.data()...);
+		}
+	}
+
+	/**
+	 * @brief Gets the number of live entities.
+	 */
+	size_t
+		size() const {
+		return m_records.size() - m_freeIds.size();
+	}
+
+	/**
+	 * @brief Gets the number of archetypes created so far.
+	 */
+	size_t
+		archetypeCount() const {
+		return m_archetypes.size();
+	}
+
+	/**
+	 * @brief Publishes the live components and reserved bytes of every dense
+	 * component type to the MemoryTracker. Call between frames.
+	 */
+	void
+		reportMemoryUsage() const;
+
+private:
+	/**
+	 * @brief Location of an entity inside the archetype storage.
+	 */
+	struct EntityRecord {
+		uint32_t archetype = 0;
+		uint32_t row = 0;
+		bool alive = false;
+	};
+
+	/**
+	 * @brief Looks up the archetype with the given signature.
+	 * @return Its index, or INVALID_INDEX if it does not exist yet.
+	 */
+	uint32_t
+		findArchetype(ComponentMask mask) const;
+
+	/**
+	 * @brief Creates a new archetype with the columns of source that are in mask,
+	 * plus an optional extra column.
+	 * @return Index of the new archetype.
+	 */
+	uint32_t
+		createArchetype(ComponentMask mask,
+		                const Archetype& source,
+		                EngineUtilities::TUniquePtr<IComponentColumn> extraColumn,
+		                ComponentTypeID extraTypeID);
+
+	/**
+	 * @brief Moves an entity row, with every column both archetypes share, to target.
+	 */
+	void
+		moveEntity(EntityID entity, uint32_t target);
+
+	/**
+	 * @brief Removes a row from an archetype and patches the entity moved into it.
+	 */
+	void
+		removeRow(Archetype& archetype, uint32_t row);
+
+	std::vector<EngineUtilities::TUniquePtr<Archetype>> m_archetypes;
+	std::unordered_map<ComponentMask, uint32_t> m_archetypeLookup;
+	std::vector<EntityRecord> m_records;
+	std::vector<EntityID> m_freeIds;
+};
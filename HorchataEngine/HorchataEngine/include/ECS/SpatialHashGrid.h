@@ -0,0 +1,191 @@
+#pragma once
+#include "../Prerequisites.h"
+#include "Registry.h"
+
+/**
+ * @class SpatialHashGrid
+ * @brief Broadphase over 2D positions: a uniform grid stored as a spatial hash.
+ *
+ * Entries are inserted every frame with clear() + insert() and indexed with
+ * build(), which counting-sorts them by cell into one flat array, so a rebuild
+ * does not allocate once the buffers have grown. Queries only visit the cells
+ * that overlap the query area. An entry lives in the cell of its center; the
+ * query area is grown by the largest inserted radius to find every overlap.
+ * Pick a cell size close to the typical query diameter.
+ */
+class
+	SpatialHashGrid {
+public:
+	/**
+	 * @brief An inserted element.
+	 */
+	struct Entry {
+		EntityID id;                  /**< Caller key, usually the EntityID. */
+		EngineMath::Vector2 position; /**< Center of the element. */
+		float radius;                 /**< Bounding radius of the element. */
+		int32_t cellX;                /**< Cell the center falls in. */
+		int32_t cellY;
+	};
+
+	/**
+	 * @brief Creates an empty grid.
+	 * @param cellSize Side of a cell in world units.
+	 */
+	explicit SpatialHashGrid(float cellSize = 64.0f);
+
+	/**
+	 * @brief Removes every entry. Buffers keep their capacity.
+	 */
+	void
+		clear();
+
+	/**
+	 * @brief Adds an element. It is visible to queries after the next build().
+	 * @param id Key reported by the queries.
+	 * @param position Center of the element.
+	 * @param radius Bounding radius of the element.
+	 */
+	void
+		insert(EntityID id, const EngineMath::Vector2& position, float radius = 0.0f);
+
+	/**
+	 * @brief Sorts the inserted entries into their cells.
+	 */
+	void
+		build();
+
+	/**
+	 * @brief Calls func(const Entry&) for every entry whose circle overlaps the query circle.
+	 * @param center Center of the query.
+	 * @param radius Radius of the query.
+	 */
+	template<typename Func>
+	void
+		queryRadius(const EngineMath::Vector2& center, float radius, Func&& func) const {
+		const float reach = radius + m_maxRadius;
+		forEachCandidate(center - EngineMath::Vector2(reach, reach),
+		                 center + EngineMath::Vector2(reach, reach),
+		                 [&](const Entry& entry) {
+			const float dx = entry.position.x - center.x;
+			const float dy = entry.position.y - center.y;
+			const float range = radius + entry.radius;
+			if (dx * dx + dy * dy <= range * range) {
+				func(entry);
+			}
+		});
+	}
+
+	/**
+	 * @brief Collects the ids of the entries that overlap the query circle.
+	 * @param results Cleared and filled with the ids found.
+	 * @return Number of ids found.
+	 */
+	size_t
+		queryRadius(const EngineMath::Vector2& center, float radius, std::vector<EntityID>& results) const;
+
+	/**
+	 * @brief Calls func(const Entry&) for every entry whose bounding box overlaps the box.
+	 * @param min Lower corner of the query box.
+	 * @param max Upper corner of the query box.
+	 */
+	template<typename Func>
+	void
+		queryAABB(const EngineMath::Vector2& min, const EngineMath::Vector2& max, Func&& func) const {
+		forEachCandidate(min - EngineMath::Vector2(m_maxRadius, m_maxRadius),
+		                 max + EngineMath::Vector2(m_maxRadius, m_maxRadius),
+		                 [&](const Entry& entry) {
+			if (entry.position.x + entry.radius >= min.x && entry.position.x - entry.radius <= max.x &&
+			    entry.position.y + entry.radius >= min.y && entry.position.y - entry.radius <= max.y) {
+				func(entry);
+			}
+		});
+	}
+
+	/**
+	 * @brief Collects the ids of the entries that overlap the query box.
+	 * @param results Cleared and filled with the ids found.
+	 * @return Number of ids found.
+	 */
+	size_t
+		queryAABB(const EngineMath::Vector2& min, const EngineMath::Vector2& max, std::vector<EntityID>& results) const;
+
+	/**
+	 * @brief Calls func(const Entry&, const Entry&) once for every pair of overlapping circles.
+	 */
+	template<typename Func>
+	void
+		forEachOverlappingPair(Func&& func) const {
+		for (size_t i = 0; i < m_entries.size(); ++i) {
+			const Entry& first = m_entries[i];
+			queryRadius(first.position, first.radius, [&](const Entry& second) {
+				// Entries are compared by address so every pair is reported once
+				if (&first < &second) {
+					func(first, second);
+				}
+			});
+		}
+	}
+
+	/**
+	 * @brief Gets the entries sorted by cell. Valid after build().
+	 */
+	const std::vector<Entry>&
+		getEntries() const {
+		return m_entries;
+	}
+
+	/**
+	 * @brief Gets the side of a cell.
+	 */
+	float
+		getCellSize() const {
+		return m_cellSize;
+	}
+
+private:
+	/**
+	 * @brief Calls func for the entries of every cell that touches [min, max].
+	 */
+	template<typename Func>
+	void
+		forEachCandidate(const EngineMath::Vector2& min, const EngineMath::Vector2& max, Func&& func) const {
+		if (m_entries.empty() || m_cellStart.empty()) {
+			return;
+		}
+		const int32_t minX = cellCoordinate(min.x);
+		const int32_t minY = cellCoordinate(min.y);
+		const int32_t maxX = cellCoordinate(max.x);
+		const int32_t maxY = cellCoordinate(max.y);
+		for (int32_t y = minY; y <= maxY; ++y) {
+			for (int32_t x = minX; x <= maxX; ++x) {
+				const uint32_t bucket = bucketIndex(x, y);
+				for (uint32_t i = m_cellStart[bucket]; i < m_cellStart[bucket + 1]; ++i) {
+					// Different cells can share a bucket, keep only the entries of this cell
+					const Entry& entry = m_entries[i];
+					if (entry.cellX == x && entry.cellY == y) {
+						func(entry);
+					}
+				}
+			}
+		}
+	}
+
+	int32_t
+		cellCoordinate(float value) const {
+		return static_cast<int32_t>(EngineMath::floor(value * m_inverseCellSize));
+	}
+
+	uint32_t
+		bucketIndex(int32_t x, int32_t y) const {
+		const uint32_t hash = static_cast<uint32_t>(x) * 73856093u ^ static_cast<uint32_t>(y) * 19349663u;
+		return hash & m_bucketMask;
+	}
+
+	float m_cellSize;
+	float m_inverseCellSize;
+	float m_maxRadius = 0.0f;
+	uint32_t m_bucketMask = 0;
+	std::vector<Entry> m_pending;      /**< Entries inserted since the last build. */
+	std::vector<Entry> m_entries;      /**< Entries sorted by bucket. */
+	std::vector<uint32_t> m_cellStart; /**< First entry of each bucket, plus an end sentinel. */
+};
@@ -0,0 +1,117 @@
+#pragma once
+#include "../Prerequisites.h"
+#include "ARacer.h"
+#include "SpatialHashGrid.h"
+
+/**
+ * @class SteeringSystem
+ * @brief Runs the steering behaviors of many racers over contiguous arrays.
+ *
+ * Racers with the same behavior instances, weights and priorities (usually one
+ * shared PathFollowing) form a group. Every frame the positions, velocities,
+ * max speeds and waypoints of every racer are gathered into arrays, each
+ * behavior of a group computes its forces once over the group's range,
+ * SteeringCombiner mixes them, and only then are all groups integrated and
+ * written back, so neighbour behaviors read the state of the frame start.
+ * When a behavior uses neighbours, the gathered positions are indexed in a
+ * SpatialHashGrid first, together with the karts the system does not steer
+ * (the player), so the racers also keep their distance from those. Chunks of a group run in parallel on the ThreadPool.
+ * Groups are only rebuilt when the racer list or the behaviors of a racer change.
+ */
+class
+	SteeringSystem {
+public:
+	/**
+	 * @brief Racers per ThreadPool job.
+	 */
+	static constexpr size_t GRAIN_SIZE = 256;
+
+	/**
+	 * @brief A kart the neighbour behaviors react to but the system does not move, e.g. the player.
+	 */
+	struct NeighborKart {
+		EngineMath::Vector2 position;
+		EngineMath::Vector2 velocity;
+	};
+
+	/**
+	 * @brief Applies the steering behaviors of every racer and moves it.
+	 * @param racers Racers to update.
+	 * @param deltaTime Time elapsed since the last update.
+	 * @param neighborKarts Karts that are only seen as neighbours by the racers.
+	 */
+	void
+		update(const std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers,
+		       float deltaTime,
+		       const std::vector<NeighborKart>& neighborKarts = {});
+
+	/**
+	 * @brief Gets the number of behavior sets the racers were grouped by.
+	 */
+	size_t
+		getGroupCount() const {
+		return m_groups.size();
+	}
+
+private:
+	/**
+	 * @brief Racers that share the same behaviors, weights and priorities.
+	 */
+	struct Group {
+		std::vector<WeightedSteering> behaviors; /**< Sorted, see WeightedSteering::operator<. */
+		size_t begin = 0; /**< First slot of the group in the arrays. */
+		size_t end = 0;   /**< One past the last slot. */
+	};
+
+	/**
+	 * @brief Checks if the racers or their behaviors changed since the groups were built.
+	 */
+	bool
+		needsRebuild(const std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers) const;
+
+	/**
+	 * @brief Groups the racers by behavior set and sizes the arrays.
+	 */
+	void
+		rebuild(const std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers);
+
+	/**
+	 * @brief Copies the state of the racers of the slots [begin, end) into the arrays.
+	 */
+	void
+		gatherRange(const std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers, size_t begin, size_t end);
+
+	/**
+	 * @brief Moves the slots [begin, end) by their forces and writes them back to the racers.
+	 */
+	void
+		integrateRange(const std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers,
+		               size_t begin,
+		               size_t end,
+		               float deltaTime);
+
+	/**
+	 * @brief Gets the arrays as a batch for the behaviors.
+	 */
+	SteeringBatch
+		makeBatch();
+
+	std::vector<Group> m_groups;
+	float m_neighborRadius = 0.f;               /**< Largest neighbour radius of the behaviors, 0 if none uses neighbours. */
+	SpatialHashGrid m_neighborGrid;             /**< Gathered positions, ids are slots. Neighbour karts take the slots after the racers. */
+	std::vector<uint32_t> m_racerOfSlot;        /**< Index in the racer list of every slot. */
+	std::vector<const ARacer*> m_racers;        /**< Racer list the groups were built for. */
+	std::vector<uint32_t> m_steeringVersions;   /**< Steering version of every racer at the last rebuild. */
+
+	std::vector<EngineMath::Vector2> m_positions;  /**< Racer slots, then the neighbour karts. */
+	std::vector<EngineMath::Vector2> m_velocities; /**< Racer slots, then the neighbour karts. */
+	std::vector<float> m_maxSpeeds;
+	std::vector<float> m_maxForces;
+	std::vector<EngineMath::Vector2> m_forces;
+	std::vector<EngineMath::Vector2> m_behaviorForces;
+	std::vector<EngineMath::Vector2> m_levelForces;
+	std::vector<float> m_budgets;
+	std::vector<uint32_t> m_waypoints;
+	std::vector<EngineMath::Vector2> m_scratchVectors;
+	std::vector<float> m_scratchFloats;
+};
@@ -0,0 +1,149 @@
+#pragma once
+#include "../Prerequisites.h"
+#include "../Threading/ThreadPool.h"
+#include <functional>
+
+/**
+ * @brief Bitmask of the data a system reads or writes, one bit per resource type.
+ * Kept apart from ComponentMask, so declaring a resource does not use up one of
+ * the Registry component types.
+ */
+using ResourceMask = uint64_t;
+
+/**
+ * @brief Maximum number of resource types with a bit of their own.
+ */
+constexpr uint32_t MAX_RESOURCE_TYPES = 64;
+
+/**
+ * @brief Hands out the bit of the next resource type.
+ * Past MAX_RESOURCE_TYPES the type is reported and gets every bit, so the systems
+ * that use it conflict with all others and still run in a safe order.
+ */
+inline ResourceMask
+nextResourceBit() {
+	static std::atomic<uint32_t> counter{ 0 };
+	const uint32_t id = counter.fetch_add(1);
+	if (id >= MAX_RESOURCE_TYPES) {
+		std::cerr << "[SystemScheduler] More than " << MAX_RESOURCE_TYPES
+		          << " resource types, the extra ones conflict with every system.\n";
+		return ~ResourceMask(0);
+	}
+	return ResourceMask(1) << id;
+}
+
+/**
+ * @brief Gets the bit of a resource type, assigned the first time it is queried.
+ * T may be an incomplete type, it only serves as a tag.
+ */
+template<typename T>
+inline ResourceMask
+resourceBit() {
+	static const ResourceMask bit = nextResourceBit();
+	return bit;
+}
+
+/**
+ * @brief Builds the mask with the bits of every type in Ts.
+ */
+template<typename... Ts>
+inline ResourceMask
+resourceMask() {
+	return (ResourceMask(0) | ... | resourceBit<Ts>());
+}
+
+/**
+ * @class SystemScheduler
+ * @brief Runs the per-frame systems of the engine, in parallel where it is safe.
+ *
+ * Every system declares the data it reads and writes as a ResourceMask (use
+ * resourceMask<Ts...>(); any type can be used, not only components, e.g. an
+ * actor class to stand for its gameplay state). Two systems conflict when one
+ * writes something the other reads or writes. Systems are grouped in stages:
+ * a system goes to the stage after the last earlier system it conflicts with,
+ * so registration order is kept for every conflicting pair and the systems of
+ * one stage run at the same time on the ThreadPool.
+ */
+class
+	SystemScheduler {
+public:
+	/**
+	 * @brief Function run by a system once per frame.
+	 */
+	using SystemFunction = std::function<void(float)>;
+
+	/**
+	 * @brief Creates a scheduler that runs its systems on the given pool.
+	 */
+	explicit SystemScheduler(ThreadPool& threadPool) : m_threadPool(threadPool) {}
+
+	/**
+	 * @brief Registers a system.
+	 * @param name Name used for debugging and profiling.
+	 * @param reads Data the system only reads.
+	 * @param writes Data the system modifies.
+	 * @param function Function called with the frame delta time.
+	 * @param mainThreadOnly Run on the thread that calls run() (input, window, GUI).
+	 */
+	void
+		addSystem(const std::string& name,
+		          ResourceMask reads,
+		          ResourceMask writes,
+		          SystemFunction function,
+		          bool mainThreadOnly = false);
+
+	/**
+	 * @brief Runs every system for one frame, stage by stage.
+	 * @param deltaTime Time elapsed since the last frame.
+	 */
+	void
+		run(float deltaTime);
+
+	/**
+	 * @brief Gets the number of stages the systems were grouped in.
+	 */
+	size_t
+		getStageCount() const {
+		return m_stages.size();
+	}
+
+	/**
+	 * @brief Gets the thread pool the systems run on.
+	 */
+	ThreadPool&
+		getThreadPool() {
+		return m_threadPool;
+	}
+
+private:
+	/**
+	 * @brief A registered system.
+	 */
+	struct System {
+		std::string name;
+		const char* zoneName = nullptr; /**< Interned name of the profiler zone. */
+		ResourceMask reads = 0;
+		ResourceMask writes = 0;
+		SystemFunction function;
+		bool mainThreadOnly = false;
+	};
+
+	/**
+	 * @brief Runs a system inside its profiler zone.
+	 */
+	static void
+		runSystem(System& system, float deltaTime);
+
+	/**
+	 * @brief Checks if two systems may not run at the same time.
+	 */
+	static bool
+		conflicts(const System& a, const System& b) {
+		return (a.writes & (b.reads | b.writes)) != 0 || (b.writes & a.reads) != 0;
+	}
+
+	ThreadPool& m_threadPool;
+	std::vector<System> m_systems;
+	std::vector<size_t> m_systemStages; /**< Stage of each system. */
+	std::vector<std::vector<size_t>> m_stages; /**< Systems of each stage. */
+};
@@ -1,6 +1,17 @@
 #pragma once
 #include "../Prerequisites.h"
 #include "Component.h"
+#include "../ResourceTable.h"
+
+/**
+ * @brief Loading state of a Texture.
+ */
+enum class
+	TextureState {
+	LOADING = 0, /**< Shows a placeholder until the image is uploaded. */
+	READY = 1,   /**< The image is on the GPU. */
+	FAILED = 2   /**< The file could not be decoded, the placeholder stays. */
+};
 
 class
 Texture : public Component {
@@ -11,7 +22,26 @@ public:
 		m_textureName(textureName), m_extension(extension), Component(TEXTURE) {
 		if (!m_texture.loadFromFile(m_textureName + "." + m_extension)) {
 			std::cout << "Error de la carga de textura: " << m_textureName << "." << m_extension << std::endl;
+			m_state = TextureState::FAILED;
+		}
+		else {
+			m_state = TextureState::READY;
+		}
+	}
+
+	/**
+	 * @brief Creates a texture that shows a placeholder until upload() is called.
+	 * Nothing is read from disk, see ResourceManager::loadTextureAsync.
+	 * @param textureName Name of the texture file, without extension.
+	 * @param extension Extension of the texture file.
+	 * @param placeholder Image shown while loading.
+	 */
+	Texture(const std::string& textureName, const std::string& extension, const sf::Image& placeholder) :
+		Component(TEXTURE), m_textureName(textureName), m_extension(extension) {
+		if (!m_texture.loadFromImage(placeholder)) {
+			std::cout << "Error de la carga de textura: " << m_textureName << "." << m_extension << std::endl;
 		}
+		m_state = TextureState::LOADING;
 	}
 
 	virtual
@@ -34,8 +64,75 @@ public:
 		return m_texture;
 	}
 
+	/**
+	 * @brief Replaces the placeholder with the decoded image. Main thread only.
+	 * @return True if the image could be uploaded.
+	 */
+	bool
+		upload(const sf::Image& image) {
+		if (!m_texture.loadFromImage(image)) {
+			m_state = TextureState::FAILED;
+			return false;
+		}
+		m_state = TextureState::READY;
+		++m_revision;
+		return true;
+	}
+
+	/**
+	 * @brief Marks the load as failed, the placeholder stays.
+	 */
+	void
+		markFailed() {
+		m_state = TextureState::FAILED;
+	}
+
+	TextureState
+		getState() const {
+		return m_state;
+	}
+
+	bool
+		isReady() const {
+		return m_state == TextureState::READY;
+	}
+
+	/**
+	 * @brief Gets a counter that changes every time new pixels are uploaded.
+	 * Shapes compare it to rebind the texture with its new size.
+	 */
+	uint32_t
+		getRevision() const {
+		return m_revision;
+	}
+
+	/**
+	 * @brief Gets the path the texture was loaded from.
+	 */
+	std::string
+		getFileName() const {
+		return m_textureName + "." + m_extension;
+	}
+
 private:
 	sf::Texture m_texture;
 	std::string m_textureName;
 	std::string m_extension;
+	TextureState m_state = TextureState::LOADING;
+	uint32_t m_revision = 0;
+};
+
+/**
+ * @brief Generational handle to a texture of the ResourceManager.
+ */
+using TextureHandle = THandle<Texture>;
+
+/**
+ * @brief Part of a texture, e.g. one sprite inside an atlas page.
+ * An empty rect stands for the whole texture.
+ */
+struct TextureRegion {
+	EngineUtilities::TSharedPointer<Texture> texture; /**< Texture (or atlas page) that holds the pixels. */
+	sf::IntRect rect; /**< Pixel rectangle inside the texture. */
+	TextureHandle handle; /**< Entry of the texture in the ResourceManager, invalid if it has none. */
 };
\ No newline at end of file
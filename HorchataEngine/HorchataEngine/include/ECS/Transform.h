@@ -14,7 +14,10 @@ public:
 								m_rotation(0.0f, 0.0f),
 								m_scale(1.0f, 1.0f),
 								m_origin(0.0f, 0.0f),
-								m_globalBounds(sf::FloatRect(sf::Vector2f(0, 0), sf::Vector2f(0, 0))) {}
+								m_globalBounds(sf::FloatRect(sf::Vector2f(0, 0), sf::Vector2f(0, 0))),
+								m_previousPosition(0.0f, 0.0f),
+								m_previousRotation(0.0f, 0.0f),
+								m_previousScale(1.0f, 1.0f) {}
 
 	/**
   * @brief Default destructor.
@@ -71,6 +74,16 @@ public:
 			m_position = position;
 	}
 
+	/**
+	 * @brief Moves the transform without interpolating from the old position (respawns, resets).
+	 * @param position The new position.
+	 */
+	void
+		teleport(const EngineMath::Vector2& position) {
+			m_position = position;
+			m_previousPosition = position;
+	}
+
 	/**
 	* @brief Gets the position of the transform.
 	* @return The current position.
@@ -152,6 +165,43 @@ public:
 			return m_globalBounds;
 	}
 
+	/**
+	 * @brief Saves the current state as the previous one, before a simulation step.
+	 */
+	void
+		storePreviousState() {
+			m_previousPosition = m_position;
+			m_previousRotation = m_rotation;
+			m_previousScale = m_scale;
+	}
+
+	/**
+	 * @brief Gets the position between the previous and the current simulation step.
+	 * @param alpha 0 gives the previous state, 1 the current one.
+	 */
+	EngineMath::Vector2
+		getInterpolatedPosition(float alpha) const {
+			return m_previousPosition + (m_position - m_previousPosition) * alpha;
+	}
+
+	/**
+	 * @brief Gets the rotation between the previous and the current simulation step.
+	 * @param alpha 0 gives the previous state, 1 the current one.
+	 */
+	EngineMath::Vector2
+		getInterpolatedRotation(float alpha) const {
+			return m_previousRotation + (m_rotation - m_previousRotation) * alpha;
+	}
+
+	/**
+	 * @brief Gets the scale between the previous and the current simulation step.
+	 * @param alpha 0 gives the previous state, 1 the current one.
+	 */
+	EngineMath::Vector2
+		getInterpolatedScale(float alpha) const {
+			return m_previousScale + (m_scale - m_previousScale) * alpha;
+	}
+
 	//float*
 		//getPosData() {
 		//return &m_position.x;
@@ -174,4 +224,13 @@ private:
 		EngineMath::Vector2 m_scale; /**< Scale factor for the transform. */
 		EngineMath::Vector2 m_origin; /**< Origin of the transform. */
 		sf::IntRect m_globalBounds; /**< Global bounds of the transform. */
-};
\ No newline at end of file
+		EngineMath::Vector2 m_previousPosition; /**< Position at the start of the last simulation step. */
+		EngineMath::Vector2 m_previousRotation; /**< Rotation at the start of the last simulation step. */
+		EngineMath::Vector2 m_previousScale; /**< Scale at the start of the last simulation step. */
+};
+
+/**
+ * @brief Transforms live by value in the Registry so systems can stream them.
+ */
+template<>
+struct IsDenseComponent<Transform> : std::true_type {};
@@ -3,6 +3,7 @@
 
 class Window;
 class Actor;
+struct RenderStats;
 
 class 
   EngineGUI {
@@ -47,6 +48,12 @@ public:
     void
       inspector(const std::vector<EngineUtilities::TSharedPointer<Actor>>& actors);
 
+    void
+      profiler(const RenderStats& renderStats);
+
+    void
+      memory();
+
     void
       vec2Control(const std::string& label,
         float* values,
@@ -55,4 +62,8 @@ public:
 
 private:
 	int selectedActorIndex = -1; // Index of the selected actor in the outliner
+	std::string profilerStatus; // Result of the last trace export
+	std::string memoryStatus; // Result of the last memory dump
+	std::vector<float> allocationHistory = std::vector<float>(300, 0.0f); // Allocations of the last frames
+	size_t allocationHistoryOffset = 0; // Oldest value of allocationHistory
 };
\ No newline at end of file
@@ -5,6 +5,11 @@
 #include "ECS/ARacer.h"
 #include "ECS/Actor.h"
 #include "CShape.h"
+#include "ECS/SpatialHashGrid.h"
+#include "TrackCollisionMask.h"
+#include "RaceRanking.h"
+#include "Path.h"
+#include "RaceProgress.h"
 #include "Prerequisites.h"
 
 /**
@@ -21,12 +26,13 @@ public:
   GameManager();
 
   /**
-   * @brief Initializes the game manager with the track actor and waypoints.
+   * @brief Initializes the game manager with the track actor and its path.
    * @param trackActor Shared pointer to the track actor.
-   * @param waypoints Vector of waypoint positions for the track.
+   * @param path Racing line of the track, its points are the waypoints.
+   * @param trackImageFile Image the collision mask is built from; empty uses the track texture file.
    */
   void
-    init(EngineUtilities::TSharedPointer<Actor> trackActor, std::vector<EngineMath::Vector2> waypoints);
+    init(EngineUtilities::TSharedPointer<Actor> trackActor, const EngineUtilities::TSharedPointer<Path>& path, const std::string& trackImageFile = "");
 
   /**
    * @brief Updates the game state, including racers and player.
@@ -44,8 +50,59 @@ public:
   void
     renderHUD(EngineUtilities::TSharedPointer<Window>& window);
 
+  /**
+   * @brief Rebuilds the racer grid and pushes apart every pair of overlapping karts.
+   * @param racers Vector of shared pointers to ARacer objects.
+   * @param player Shared pointer to the player object.
+   */
+  void
+    resolveRacerCollisions(std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers, EngineUtilities::TSharedPointer<APlayer>& player);
+
+  /**
+   * @brief Gets the grid with the kart positions of the last collision pass.
+   * Ids are the EntityIDs of the actors.
+   */
+  const SpatialHashGrid&
+    getRacerGrid() const {
+    return m_racerGrid;
+  }
+
+  /**
+   * @brief Gets the death zones of the track, with their distance field.
+   * Built by init; shared so behaviors like WallAvoidance read the same mask.
+   */
+  const EngineUtilities::TSharedPointer<TrackCollisionMask>&
+    getTrackMask() const {
+    return m_trackMask;
+  }
+
+  /**
+   * @brief Gets the progress along the path of the last update. Participant 0
+   * is the player, participant i + 1 is racers[i].
+   */
+  const RaceProgress&
+    getProgress() const {
+    return m_progress;
+  }
+
+  /**
+   * @brief Gets the race positions of the last update. Participant 0 is the
+   * player, participant i + 1 is racers[i].
+   */
+  const RaceRanking&
+    getRanking() const {
+    return m_ranking;
+  }
+
 private:
 
+  /**
+   * @brief Projects every kart onto the path in one pass, then sets their next waypoint and lap.
+   * @param racers Vector of shared pointers to ARacer objects.
+   * @param player Shared pointer to the player object.
+   */
+  void updateProgress(std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers, EngineUtilities::TSharedPointer<APlayer>& player);
+
   /**
    * @brief Updates the ranking of racers and player for the leaderboard.
    * @param racers Vector of shared pointers to ARacer objects.
@@ -54,10 +111,16 @@ private:
   void updateRanks(std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers, EngineUtilities::TSharedPointer<APlayer>& player);
 
   /**
-   * @brief Checks for collisions between the player and the track.
+   * @brief Sends every kart that drove onto a death zone back to its previous waypoint.
+   * @param racers Vector of shared pointers to ARacer objects.
    * @param player Shared pointer to the player object.
    */
-  void checkCollisions(EngineUtilities::TSharedPointer<APlayer>& player);
+  void checkCollisions(std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers, EngineUtilities::TSharedPointer<APlayer>& player);
+
+  /**
+   * @brief Resets a transform to the waypoint before currentWaypoint if it is on a death zone.
+   */
+  void checkTrackCollision(Transform& transform, size_t currentWaypoint);
 
   /**
    * @brief Shared pointer to the track actor.
@@ -65,9 +128,19 @@ private:
   EngineUtilities::TSharedPointer<Actor> m_trackActor;
 
   /**
-   * @brief Vector of waypoint positions for the track.
+   * @brief Racing line of the track, shared with the racers.
+   */
+  EngineUtilities::TSharedPointer<Path> m_path;
+
+  /**
+   * @brief Progress of the player (participant 0) and racers along the path.
    */
-  std::vector<EngineMath::Vector2> m_waypoints;
+  RaceProgress m_progress;
+
+  /**
+   * @brief Kart positions gathered for the progress pass, reused every frame.
+   */
+  std::vector<EngineMath::Vector2> m_positions;
 
   /**
    * @brief Game clock for tracking elapsed time.
@@ -80,12 +153,22 @@ private:
   float m_timeInSeconds = 0.f;
 
   /**
-   * @brief Leaderboard containing pairs of racer/player names and their ranks.
+   * @brief Leaderboard of the player and racers, kept sorted between frames.
+   */
+  RaceRanking m_ranking;
+
+  /**
+   * @brief Death zones of the track, one bit per pixel of the track image.
+   */
+  EngineUtilities::TSharedPointer<TrackCollisionMask> m_trackMask;
+
+  /**
+   * @brief Broadphase with the position of every kart, rebuilt each frame.
    */
-  std::vector<std::pair<std::string, int>> m_leaderboard;
+  SpatialHashGrid m_racerGrid{ 64.f };
 
   /**
-   * @brief Image used for track collision detection.
+   * @brief Collision radius of a kart.
    */
-  sf::Image m_trackCollisionImage;
+  float m_kartRadius = 12.f;
 };
\ No newline at end of file
@@ -0,0 +1,378 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+/**
+ * @brief Con 0 los punteros inteligentes no registran nada en el MemoryTracker.
+ *
+ * Registrar cuesta varias operaciones atómicas sobre contadores compartidos por
+ * cada objeto creado o destruido (más del doble del coste de MakeShared), así que
+ * por defecto solo está activo en Debug. Definirlo a 1 para medir una build Release.
+ */
+#ifndef HORCHATA_MEMORY_TRACKER
+#ifdef NDEBUG
+#define HORCHATA_MEMORY_TRACKER 0
+#else
+#define HORCHATA_MEMORY_TRACKER 1
+#endif
+#endif
+
+namespace EngineUtilities {
+	/**
+	 * @brief Uso de memoria de un tipo (o categoría) en un momento dado.
+	 */
+	struct MemoryTypeStats
+	{
+		std::string name;
+		int64_t liveCount = 0;    ///< Objetos vivos.
+		int64_t liveBytes = 0;    ///< Bytes vivos.
+		int64_t peakBytes = 0;    ///< Máximo de bytes vivos alcanzado.
+		uint64_t allocations = 0; ///< Reservas desde el inicio.
+	};
+
+	/**
+	 * @brief Contabilidad de memoria por tipo.
+	 *
+	 * MakeShared, MakeSharedPooled y TUniquePtr registran cada objeto que crean y
+	 * destruyen bajo el nombre de su tipo; otros sistemas (Registry,
+	 * ResourceManager) publican su uso con setUsage(). Cada tipo tiene un hueco con
+	 * contadores atómicos, así que registrar es lock-free y seguro entre hilos; el
+	 * mutex solo se toma la primera vez que aparece un tipo.
+	 * Los tamaños son los estáticos (sizeof del tipo del puntero, bloque de
+	 * control incluido), no cuentan memoria que el objeto reserve por su cuenta.
+	 */
+	class MemoryTracker
+	{
+	public:
+		/**
+		 * @brief Número máximo de tipos distintos.
+		 */
+		static constexpr uint32_t MAX_TYPES = 512;
+
+		/**
+		 * @brief Si los punteros inteligentes registran sus objetos (HORCHATA_MEMORY_TRACKER).
+		 *
+		 * Si no, solo aparecen los sistemas que publican su uso con setUsage().
+		 */
+		static constexpr bool TRACKS_OBJECTS = HORCHATA_MEMORY_TRACKER != 0;
+
+		/**
+		 * @brief Obtener el tracker global.
+		 *
+		 * Nunca se destruye, para que los objetos que se liberen al cerrar el
+		 * programa aún puedan registrarse.
+		 */
+		static MemoryTracker& getInstance()
+		{
+			static MemoryTracker* instance = new MemoryTracker();
+			return *instance;
+		}
+
+		MemoryTracker(const MemoryTracker&) = delete;
+		MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+		/**
+		 * @brief Nombre legible de un tipo.
+		 */
+		template<typename T>
+		static std::string typeName()
+		{
+			const char* name = typeid(T).name();
+#if defined(__GNUG__)
+			int status = 0;
+			char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+			if (status == 0 && demangled)
+			{
+				std::string result(demangled);
+				std::free(demangled);
+				return result;
+			}
+#endif
+			return name;
+		}
+
+		/**
+		 * @brief Hueco de un tipo, asignado la primera vez que se pide.
+		 */
+		template<typename T>
+		static uint32_t typeSlot()
+		{
+			static const uint32_t slot = getInstance().registerName(typeName<T>());
+			return slot;
+		}
+
+		/**
+		 * @brief Hueco de un nombre; el mismo nombre siempre da el mismo hueco.
+		 *
+		 * Los nombres que no caben en MAX_TYPES comparten el último hueco ("Other").
+		 */
+		uint32_t registerName(const std::string& name)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto it = m_slotByName.find(name);
+			if (it != m_slotByName.end())
+			{
+				return it->second;
+			}
+			uint32_t slot = m_slotCount.load(std::memory_order_relaxed);
+			if (slot >= MAX_TYPES - 1)
+			{
+				m_slotCount.store(MAX_TYPES, std::memory_order_release);
+				return MAX_TYPES - 1;
+			}
+			m_names[slot] = name;
+			m_slotByName[name] = slot;
+			m_slotCount.store(slot + 1, std::memory_order_release);
+			return slot;
+		}
+
+		/**
+		 * @brief Registra la creación de un objeto.
+		 */
+		void recordAllocation(uint32_t slot, size_t bytes)
+		{
+			Slot& entry = m_slots[slot];
+			entry.liveCount.fetch_add(1, std::memory_order_relaxed);
+			entry.allocations.fetch_add(1, std::memory_order_relaxed);
+			updatePeak(entry.peakBytes, entry.liveBytes.fetch_add(int64_t(bytes), std::memory_order_relaxed) + int64_t(bytes));
+			updatePeak(m_peakBytes, m_liveBytes.fetch_add(int64_t(bytes), std::memory_order_relaxed) + int64_t(bytes));
+			m_frameAllocations.fetch_add(1, std::memory_order_relaxed);
+			m_frameBytes.fetch_add(bytes, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Registra la destrucción de un objeto.
+		 */
+		void recordFree(uint32_t slot, size_t bytes)
+		{
+			Slot& entry = m_slots[slot];
+			entry.liveCount.fetch_sub(1, std::memory_order_relaxed);
+			entry.liveBytes.fetch_sub(int64_t(bytes), std::memory_order_relaxed);
+			m_liveBytes.fetch_sub(int64_t(bytes), std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Publica el uso actual de un sistema que gestiona su propia memoria.
+		 *
+		 * Sustituye los valores vivos del hueco; no cuenta como reservas del frame.
+		 */
+		void setUsage(uint32_t slot, int64_t count, int64_t bytes)
+		{
+			Slot& entry = m_slots[slot];
+			entry.liveCount.store(count, std::memory_order_relaxed);
+			const int64_t previous = entry.liveBytes.exchange(bytes, std::memory_order_relaxed);
+			updatePeak(entry.peakBytes, bytes);
+			updatePeak(m_peakBytes, m_liveBytes.fetch_add(bytes - previous, std::memory_order_relaxed) + bytes - previous);
+		}
+
+		template<typename T>
+		static void onAllocate(size_t bytes)
+		{
+#if HORCHATA_MEMORY_TRACKER
+			getInstance().recordAllocation(typeSlot<T>(), bytes);
+#else
+			(void)bytes;
+#endif
+		}
+
+		template<typename T>
+		static void onFree(size_t bytes)
+		{
+#if HORCHATA_MEMORY_TRACKER
+			getInstance().recordFree(typeSlot<T>(), bytes);
+#else
+			(void)bytes;
+#endif
+		}
+
+		/**
+		 * @brief Cierra el frame: guarda sus reservas y empieza a contar las del siguiente.
+		 */
+		void endFrame()
+		{
+			m_lastFrameAllocations = m_frameAllocations.exchange(0, std::memory_order_relaxed);
+			m_lastFrameBytes = m_frameBytes.exchange(0, std::memory_order_relaxed);
+			m_maxFrameAllocations = std::max(m_maxFrameAllocations, m_lastFrameAllocations);
+			++m_frameCount;
+		}
+
+		/**
+		 * @brief Olvida las estadísticas por frame (por ejemplo, tras la carga inicial).
+		 */
+		void resetFrameStats()
+		{
+			m_frameAllocations.store(0, std::memory_order_relaxed);
+			m_frameBytes.store(0, std::memory_order_relaxed);
+			m_lastFrameAllocations = 0;
+			m_lastFrameBytes = 0;
+			m_maxFrameAllocations = 0;
+			m_frameCount = 0;
+		}
+
+		/**
+		 * @brief Copia el estado de todos los tipos, de más a menos bytes vivos.
+		 */
+		std::vector<MemoryTypeStats> snapshot() const
+		{
+			const uint32_t count = m_slotCount.load(std::memory_order_acquire);
+			std::vector<MemoryTypeStats> stats(count);
+			for (uint32_t slot = 0; slot < count; ++slot)
+			{
+				stats[slot].name = m_names[slot];
+				stats[slot].liveCount = m_slots[slot].liveCount.load(std::memory_order_relaxed);
+				stats[slot].liveBytes = m_slots[slot].liveBytes.load(std::memory_order_relaxed);
+				stats[slot].peakBytes = m_slots[slot].peakBytes.load(std::memory_order_relaxed);
+				stats[slot].allocations = m_slots[slot].allocations.load(std::memory_order_relaxed);
+			}
+			std::sort(stats.begin(), stats.end(), [](const MemoryTypeStats& a, const MemoryTypeStats& b) {
+				return a.liveBytes > b.liveBytes;
+			});
+			return stats;
+		}
+
+		int64_t getLiveBytes() const { return m_liveBytes.load(std::memory_order_relaxed); }
+
+		int64_t getPeakBytes() const { return m_peakBytes.load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Reservas del último frame cerrado con endFrame().
+		 */
+		uint64_t getLastFrameAllocations() const { return m_lastFrameAllocations; }
+
+		uint64_t getLastFrameBytes() const { return m_lastFrameBytes; }
+
+		/**
+		 * @brief Mayor número de reservas en un frame desde resetFrameStats().
+		 */
+		uint64_t getMaxFrameAllocations() const { return m_maxFrameAllocations; }
+
+		uint64_t getFrameCount() const { return m_frameCount; }
+
+		/**
+		 * @brief Escribe el estado completo en JSON.
+		 */
+		void writeJson(std::ostream& output) const
+		{
+			output << "{\n"
+			       << "  \"tracksObjects\": " << (TRACKS_OBJECTS ? "true" : "false") << ",\n"
+			       << "  \"frames\": " << m_frameCount << ",\n"
+			       << "  \"liveBytes\": " << getLiveBytes() << ",\n"
+			       << "  \"peakBytes\": " << getPeakBytes() << ",\n"
+			       << "  \"lastFrameAllocations\": " << m_lastFrameAllocations << ",\n"
+			       << "  \"lastFrameBytes\": " << m_lastFrameBytes << ",\n"
+			       << "  \"maxFrameAllocations\": " << m_maxFrameAllocations << ",\n"
+			       << "  \"types\": [";
+			const std::vector<MemoryTypeStats> stats = snapshot();
+			for (size_t i = 0; i < stats.size(); ++i)
+			{
+				output << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"";
+				for (char c : stats[i].name)
+				{
+					if (c == '"' || c == '\\')
+					{
+						output << '\\';
+					}
+					output << c;
+				}
+				output << "\", \"liveCount\": " << stats[i].liveCount
+				       << ", \"liveBytes\": " << stats[i].liveBytes
+				       << ", \"peakBytes\": " << stats[i].peakBytes
+				       << ", \"allocations\": " << stats[i].allocations << "}";
+			}
+			output << "\n  ]\n}\n";
+		}
+
+		/**
+		 * @brief Escribe el estado en un archivo JSON.
+		 *
+		 * @return true si se pudo escribir.
+		 */
+		bool writeJson(const std::string& fileName) const
+		{
+			std::ofstream output(fileName, std::ios::trunc);
+			if (!output)
+			{
+				return false;
+			}
+			writeJson(output);
+			return static_cast<bool>(output);
+		}
+
+	private:
+		MemoryTracker()
+		{
+			m_names[MAX_TYPES - 1] = "Other";
+		}
+
+		struct Slot
+		{
+			std::atomic<int64_t> liveCount{ 0 };
+			std::atomic<int64_t> liveBytes{ 0 };
+			std::atomic<int64_t> peakBytes{ 0 };
+			std::atomic<uint64_t> allocations{ 0 };
+		};
+
+		static void updatePeak(std::atomic<int64_t>& peak, int64_t value)
+		{
+			int64_t current = peak.load(std::memory_order_relaxed);
+			while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		Slot m_slots[MAX_TYPES];
+		std::string m_names[MAX_TYPES];
+		std::atomic<uint32_t> m_slotCount{ 0 };
+		std::unordered_map<std::string, uint32_t> m_slotByName;
+		std::mutex m_mutex;
+
+		std::atomic<int64_t> m_liveBytes{ 0 };
+		std::atomic<int64_t> m_peakBytes{ 0 };
+		std::atomic<uint64_t> m_frameAllocations{ 0 };
+		std::atomic<uint64_t> m_frameBytes{ 0 };
+		uint64_t m_lastFrameAllocations = 0;
+		uint64_t m_lastFrameBytes = 0;
+		uint64_t m_maxFrameAllocations = 0;
+		uint64_t m_frameCount = 0;
+	};
+}
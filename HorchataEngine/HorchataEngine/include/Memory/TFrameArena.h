@@ -0,0 +1,261 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace EngineUtilities {
+	/**
+	 * @brief Arena lineal para objetos que solo viven durante un frame.
+	 *
+	 * Reservar es avanzar un desplazamiento; no hay liberación individual. Al final
+	 * de cada frame reset() llama a los destructores pendientes y rebobina la arena.
+	 * Si un frame no cabe, se encadena otro bloque y en el siguiente reset() la
+	 * arena se rehace con la capacidad total, así que tras unos frames ya no
+	 * vuelve a reservar memoria. Es segura entre hilos.
+	 */
+	class FrameArena
+	{
+	public:
+		/**
+		 * @brief Constructor.
+		 *
+		 * @param capacity Capacidad inicial en bytes.
+		 */
+		explicit FrameArena(size_t capacity = 1024 * 1024)
+		{
+			addBlock(capacity);
+		}
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		~FrameArena()
+		{
+			reset();
+			for (Block& block : m_blocks)
+			{
+				::operator delete(block.data);
+			}
+		}
+
+		/**
+		 * @brief Obtener la arena del bucle principal; BaseApp la reinicia en cada frame.
+		 */
+		static FrameArena& getInstance()
+		{
+			static FrameArena instance;
+			return instance;
+		}
+
+		/**
+		 * @brief Reserva memoria sin inicializar válida hasta el próximo reset().
+		 *
+		 * @param size Tamaño en bytes.
+		 * @param alignment Alineación requerida (potencia de dos).
+		 */
+		void* allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return allocateUnlocked(size, alignment);
+		}
+
+		/**
+		 * @brief Construye un objeto en la arena.
+		 *
+		 * Su destructor, si no es trivial, se llama en el próximo reset().
+		 *
+		 * @return Puntero al objeto; no se debe borrar con delete.
+		 */
+		template<typename T, typename... Args>
+		T* create(Args&&... args)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			T* object = new (allocateUnlocked(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+			if (!std::is_trivially_destructible<T>::value)
+			{
+				m_destructors.push_back({ [](void* p) { static_cast<T*>(p)->~T(); }, object });
+			}
+			return object;
+		}
+
+		/**
+		 * @brief Destruye los objetos del frame y deja la arena vacía.
+		 */
+		void reset()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (size_t i = m_destructors.size(); i-- > 0;)
+			{
+				m_destructors[i].destroy(m_destructors[i].object);
+			}
+			m_destructors.clear();
+
+			// Unir los bloques extra en uno solo con la capacidad total
+			if (m_blocks.size() > 1)
+			{
+				size_t total = 0;
+				for (Block& block : m_blocks)
+				{
+					total += block.size;
+					::operator delete(block.data);
+				}
+				m_blocks.clear();
+				addBlock(total);
+			}
+			m_offset = 0;
+			m_used = 0;
+		}
+
+		/**
+		 * @brief Bytes reservados en el frame actual.
+		 */
+		size_t getUsed() const
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_used;
+		}
+
+		/**
+		 * @brief Mayor número de bytes usados en un frame.
+		 */
+		size_t getPeak() const
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_peak;
+		}
+
+		size_t getCapacity() const
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			size_t total = 0;
+			for (const Block& block : m_blocks)
+			{
+				total += block.size;
+			}
+			return total;
+		}
+
+	private:
+		struct Block
+		{
+			unsigned char* data;
+			size_t size;
+		};
+
+		struct PendingDestructor
+		{
+			void (*destroy)(void*);
+			void* object;
+		};
+
+		void addBlock(size_t size)
+		{
+			m_blocks.push_back({ static_cast<unsigned char*>(::operator new(size)), size });
+			m_offset = 0;
+		}
+
+		void* allocateUnlocked(size_t size, size_t alignment)
+		{
+			Block* block = &m_blocks.back();
+			uintptr_t base = reinterpret_cast<uintptr_t>(block->data);
+			size_t start = ((base + m_offset + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+
+			if (start + size > block->size)
+			{
+				// No cabe: encadenar un bloque con espacio de sobra para este frame
+				size_t newSize = block->size * 2;
+				while (newSize < size + alignment)
+				{
+					newSize *= 2;
+				}
+				addBlock(newSize);
+				block = &m_blocks.back();
+				base = reinterpret_cast<uintptr_t>(block->data);
+				start = ((base + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+			}
+
+			m_offset = start + size;
+			m_used += size;
+			if (m_used > m_peak)
+			{
+				m_peak = m_used;
+			}
+			return block->data + start;
+		}
+
+		std::vector<Block> m_blocks;
+		std::vector<PendingDestructor> m_destructors;
+		size_t m_offset = 0;
+		size_t m_used = 0;
+		size_t m_peak = 0;
+		mutable std::mutex m_mutex;
+	};
+
+	/**
+	 * @brief Allocator para contenedores de la STL que toman su memoria de un FrameArena.
+	 *
+	 * deallocate() no hace nada: la memoria se recupera en FrameArena::reset(), así que
+	 * el contenedor debe destruirse antes de que termine el frame.
+	 */
+	template<typename T>
+	class TArenaAllocator
+	{
+	public:
+		using value_type = T;
+
+		explicit TArenaAllocator(FrameArena& arena = FrameArena::getInstance()) : m_arena(&arena) {}
+
+		template<typename U>
+		TArenaAllocator(const TArenaAllocator<U>& other) : m_arena(other.getArena()) {}
+
+		T* allocate(size_t count)
+		{
+			return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T*, size_t) {}
+
+		FrameArena* getArena() const { return m_arena; }
+
+		template<typename U>
+		bool operator==(const TArenaAllocator<U>& other) const { return m_arena == other.getArena(); }
+
+		template<typename U>
+		bool operator!=(const TArenaAllocator<U>& other) const { return m_arena != other.getArena(); }
+
+	private:
+		FrameArena* m_arena;
+	};
+}
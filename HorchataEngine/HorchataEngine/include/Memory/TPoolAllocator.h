@@ -0,0 +1,277 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "TSharedPointer.h"
+#include "TUniquePtr.h"
+
+namespace EngineUtilities {
+	/**
+	 * @brief Pool de bloques de memoria de tamaño fijo.
+	 *
+	 * Reserva la memoria por trozos (chunks) de varios bloques y encadena los bloques
+	 * libres en una lista intrusiva, así que reservar y liberar son O(1) y no pasan
+	 * por malloc. Los trozos no se devuelven al sistema hasta destruir el pool, por lo
+	 * que crear y destruir miles de objetos por segundo no fragmenta el heap.
+	 * Es seguro usarlo desde varios hilos.
+	 */
+	class FixedSizePool
+	{
+	public:
+		/**
+		 * @brief Constructor.
+		 *
+		 * @param blockSize Tamaño de cada bloque en bytes.
+		 * @param alignment Alineación de cada bloque.
+		 * @param blocksPerChunk Bloques reservados cada vez que el pool crece.
+		 */
+		FixedSizePool(size_t blockSize, size_t alignment, size_t blocksPerChunk = 256)
+			: m_alignment(alignment < alignof(FreeBlock) ? alignof(FreeBlock) : alignment),
+			  m_blocksPerChunk(blocksPerChunk > 0 ? blocksPerChunk : 1)
+		{
+			// Cada bloque debe poder guardar el enlace de la lista libre y mantener la alineación
+			size_t size = blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize;
+			m_blockSize = (size + m_alignment - 1) / m_alignment * m_alignment;
+		}
+
+		FixedSizePool(const FixedSizePool&) = delete;
+		FixedSizePool& operator=(const FixedSizePool&) = delete;
+
+		/**
+		 * @brief Destructor. Libera todos los trozos; los bloques en uso quedan inválidos.
+		 */
+		~FixedSizePool()
+		{
+			for (void* chunk : m_chunks)
+			{
+				::operator delete(chunk, std::align_val_t(m_alignment));
+			}
+		}
+
+		/**
+		 * @brief Toma un bloque libre, creciendo el pool si no queda ninguno.
+		 *
+		 * @return Puntero a un bloque de getBlockSize() bytes sin inicializar.
+		 */
+		void* allocate()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_freeList)
+			{
+				grow();
+			}
+			FreeBlock* block = m_freeList;
+			m_freeList = block->next;
+			++m_usedBlocks;
+			return block;
+		}
+
+		/**
+		 * @brief Devuelve un bloque al pool.
+		 *
+		 * @param block Bloque obtenido con allocate() de este mismo pool.
+		 */
+		void deallocate(void* block)
+		{
+			if (!block)
+			{
+				return;
+			}
+			std::lock_guard<std::mutex> lock(m_mutex);
+			FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+			freeBlock->next = m_freeList;
+			m_freeList = freeBlock;
+			--m_usedBlocks;
+		}
+
+		size_t getBlockSize() const { return m_blockSize; }
+
+		/**
+		 * @brief Número de bloques entregados y aún no devueltos.
+		 */
+		size_t getUsedBlocks() const
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_usedBlocks;
+		}
+
+		/**
+		 * @brief Número total de bloques reservados.
+		 */
+		size_t getCapacity() const
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_chunks.size() * m_blocksPerChunk;
+		}
+
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		/**
+		 * @brief Reserva un trozo nuevo y agrega sus bloques a la lista libre.
+		 */
+		void grow()
+		{
+			unsigned char* chunk = static_cast<unsigned char*>(
+				::operator new(m_blockSize * m_blocksPerChunk, std::align_val_t(m_alignment)));
+			m_chunks.push_back(chunk);
+
+			// Encadenar al revés para que los bloques se entreguen en orden de dirección
+			for (size_t i = m_blocksPerChunk; i-- > 0;)
+			{
+				FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * m_blockSize);
+				block->next = m_freeList;
+				m_freeList = block;
+			}
+		}
+
+		size_t m_blockSize;
+		size_t m_alignment;
+		size_t m_blocksPerChunk;
+		FreeBlock* m_freeList = nullptr;
+		size_t m_usedBlocks = 0;
+		std::vector<void*> m_chunks;
+		mutable std::mutex m_mutex;
+	};
+
+	/**
+	 * @brief Pool de un tipo concreto.
+	 *
+	 * Cada tipo tiene su propio pool con bloques de sizeof(T). El pool nunca se
+	 * destruye: así los objetos que aún vivan al cerrar el programa (por ejemplo,
+	 * dentro de otros singletons) pueden devolverse sin tocar memoria liberada.
+	 */
+	template<typename T>
+	class TObjectPool
+	{
+	public:
+		static FixedSizePool& get()
+		{
+			static FixedSizePool* pool = new FixedSizePool(sizeof(T), alignof(T));
+			return *pool;
+		}
+	};
+
+	/**
+	 * @brief Base que hace que new/delete de Derived usen TObjectPool<Derived>.
+	 *
+	 * Las clases que hereden de Derived y cambien el tamaño vuelven al heap global,
+	 * por lo que es seguro heredar de una clase con pool.
+	 */
+	template<typename Derived>
+	class TPoolAllocated
+	{
+	public:
+		static void* operator new(size_t size)
+		{
+			if (size != sizeof(Derived))
+			{
+				return ::operator new(size);
+			}
+			return TObjectPool<Derived>::get().allocate();
+		}
+
+		static void operator delete(void* block, size_t size)
+		{
+			if (size != sizeof(Derived))
+			{
+				::operator delete(block);
+				return;
+			}
+			TObjectPool<Derived>::get().deallocate(block);
+		}
+	};
+
+	/**
+	 * @brief Bloque de control de MakeSharedPooled: objeto y recuento en un bloque del pool.
+	 */
+	template<typename T, typename Policy>
+	class TPooledBlock : public TInplaceBlock<T, Policy>,
+	                     public TPoolAllocated<TPooledBlock<T, Policy>>
+	{
+	public:
+		using TInplaceBlock<T, Policy>::TInplaceBlock;
+		using TPoolAllocated<TPooledBlock<T, Policy>>::operator new;
+		using TPoolAllocated<TPooledBlock<T, Policy>>::operator delete;
+	};
+
+	/**
+	 * @brief T con new/delete del pool, para que TUniquePtr<T> lo libere en el pool.
+	 *
+	 * Requiere un destructor virtual en T: TUniquePtr<T> borra a través de T*, y solo
+	 * así se llama al operator delete de esta clase.
+	 */
+	template<typename T>
+	class TPooled : public T, public TPoolAllocated<TPooled<T>>
+	{
+	public:
+		static_assert(std::has_virtual_destructor<T>::value,
+		              "MakeUniquePooled requiere un destructor virtual en T");
+
+		template<typename... Args>
+		explicit TPooled(Args&&... args) : T(std::forward<Args>(args)...) {}
+
+		using TPoolAllocated<TPooled<T>>::operator new;
+		using TPoolAllocated<TPooled<T>>::operator delete;
+	};
+
+	/**
+	 * @brief Como MakeShared, pero el objeto y su bloque de control salen del pool del tipo.
+	 *
+	 * @tparam T Tipo del objeto gestionado.
+	 * @param args Argumentos del constructor del objeto gestionado.
+	 * @return Un TSharedPointer gestionando un nuevo objeto de tipo T.
+	 */
+	template<typename T, typename... Args>
+	TSharedPointer<T> MakeSharedPooled(Args&&... args)
+	{
+		auto* block = new TPooledBlock<T, DefaultRefCountPolicy>(std::forward<Args>(args)...);
+		return TSharedPointer<T>(block->get(), block, AdoptRefTag{});
+	}
+
+	/**
+	 * @brief Como MakeUnique, pero el objeto sale del pool del tipo.
+	 *
+	 * @tparam T Tipo del objeto gestionado, con destructor virtual.
+	 * @param args Argumentos del constructor del objeto gestionado.
+	 * @return Un TUniquePtr gestionando un nuevo objeto de tipo T.
+	 */
+	template<typename T, typename... Args>
+	TUniquePtr<T> MakeUniquePooled(Args&&... args)
+	{
+		return TUniquePtr<T>(new TPooled<T>(std::forward<Args>(args)...));
+	}
+}
@@ -27,142 +27,378 @@
  * SOFTWARE.
 */
 #pragma once
+#include <atomic>
+#include <new>
+#include <utility>
+#include "MemoryTracker.h"
 
 namespace EngineUtilities {
 	/**
-	 * @brief Clase TSharedPointer para manejar la gesti�n de memoria compartida.
+	 * @brief Política de recuento no atómica.
+	 *
+	 * Es la más rápida; válida mientras los punteros de un mismo objeto solo se
+	 * copien y destruyan desde un hilo a la vez.
+	 */
+	struct NonAtomicRefCount
+	{
+		using Counter = int;
+
+		static void increment(Counter& counter) { ++counter; }
+
+		/**
+		 * @return true si el contador llegó a cero.
+		 */
+		static bool decrement(Counter& counter) { return --counter == 0; }
+
+		/**
+		 * @brief Incrementa el contador solo si no es cero (usado por TWeakPointer::lock).
+		 */
+		static bool incrementIfNotZero(Counter& counter)
+		{
+			if (counter == 0)
+			{
+				return false;
+			}
+			++counter;
+			return true;
+		}
+
+		static int load(const Counter& counter) { return counter; }
+	};
+
+	/**
+	 * @brief Política de recuento atómica.
+	 *
+	 * Permite copiar y destruir punteros al mismo objeto desde varios hilos. El
+	 * objeto en sí no queda protegido, solo su tiempo de vida.
+	 */
+	struct AtomicRefCount
+	{
+		using Counter = std::atomic<int>;
+
+		static void increment(Counter& counter) { counter.fetch_add(1, std::memory_order_relaxed); }
+
+		static bool decrement(Counter& counter)
+		{
+			// acq_rel: las escrituras de todos los dueños son visibles antes de destruir
+			return counter.fetch_sub(1, std::memory_order_acq_rel) == 1;
+		}
+
+		static bool incrementIfNotZero(Counter& counter)
+		{
+			int current = counter.load(std::memory_order_relaxed);
+			while (current != 0)
+			{
+				if (counter.compare_exchange_weak(current, current + 1, std::memory_order_relaxed))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		static int load(const Counter& counter) { return counter.load(std::memory_order_acquire); }
+	};
+
+	/**
+	 * @brief Política usada por TSharedPointer<T> cuando no se indica otra.
+	 *
+	 * Definir HORCHATA_ATOMIC_REFCOUNT en el proyecto hace atómicos todos los
+	 * punteros compartidos; sin la macro se puede pedir por puntero con
+	 * TSharedPointer<T, AtomicRefCount> o MakeSharedAtomic<T>().
+	 */
+#if defined(HORCHATA_ATOMIC_REFCOUNT)
+	using DefaultRefCountPolicy = AtomicRefCount;
+#else
+	using DefaultRefCountPolicy = NonAtomicRefCount;
+#endif
+
+	/**
+	 * @brief Bloque de control compartido por todos los TSharedPointer y
+	 * TWeakPointer de un mismo objeto.
+	 *
+	 * Guarda las referencias fuertes y débiles. Los punteros fuertes, en conjunto,
+	 * cuentan como una referencia débil, así que el bloque vive hasta que se
+	 * suelta el último puntero de cualquiera de los dos tipos.
+	 */
+	template<typename Policy>
+	class TRefCountBlock
+	{
+	public:
+		TRefCountBlock() : m_strong(1), m_weak(1) {}
+		TRefCountBlock(const TRefCountBlock&) = delete;
+		TRefCountBlock& operator=(const TRefCountBlock&) = delete;
+
+		void addStrong() { Policy::increment(m_strong); }
+
+		/**
+		 * @brief Suelta una referencia fuerte; destruye el objeto con la última.
+		 */
+		void releaseStrong()
+		{
+			if (Policy::decrement(m_strong))
+			{
+				destroyObject();
+				releaseWeak();
+			}
+		}
+
+		/**
+		 * @brief Toma una referencia fuerte solo si el objeto sigue vivo.
+		 */
+		bool tryAddStrong() { return Policy::incrementIfNotZero(m_strong); }
+
+		void addWeak() { Policy::increment(m_weak); }
+
+		/**
+		 * @brief Suelta una referencia débil; libera el bloque con la última.
+		 */
+		void releaseWeak()
+		{
+			if (Policy::decrement(m_weak))
+			{
+				destroyBlock();
+			}
+		}
+
+		/**
+		 * @brief Número de TSharedPointer que apuntan al objeto.
+		 */
+		int strongCount() const { return Policy::load(m_strong); }
+
+	protected:
+		virtual ~TRefCountBlock() = default;
+
+		/**
+		 * @brief Destruye el objeto gestionado.
+		 */
+		virtual void destroyObject() = 0;
+
+		/**
+		 * @brief Libera la memoria del bloque (y del objeto si comparten reserva).
+		 */
+		virtual void destroyBlock() { delete this; }
+
+	private:
+		typename Policy::Counter m_strong;
+		typename Policy::Counter m_weak;
+	};
+
+	/**
+	 * @brief Bloque de control para un objeto reservado por separado (TSharedPointer(T*)).
+	 */
+	template<typename T, typename Policy>
+	class TPointerBlock : public TRefCountBlock<Policy>
+	{
+	public:
+		explicit TPointerBlock(T* object) : m_object(object)
+		{
+			MemoryTracker::onAllocate<T>(sizeof(T) + sizeof(TPointerBlock));
+		}
+
+	protected:
+		~TPointerBlock() override { MemoryTracker::onFree<T>(sizeof(T) + sizeof(TPointerBlock)); }
+
+		void destroyObject() override { delete m_object; }
+
+	private:
+		T* m_object;
+	};
+
+	/**
+	 * @brief Bloque de control que contiene al objeto: una sola reserva para los dos.
+	 *
+	 * Lo crea MakeShared. Además de ahorrar una reserva, el contador queda junto al
+	 * objeto en memoria, así que copiar el puntero y usar el objeto tocan la misma
+	 * línea de caché.
+	 */
+	template<typename T, typename Policy>
+	class TInplaceBlock : public TRefCountBlock<Policy>
+	{
+	public:
+		template<typename... Args>
+		explicit TInplaceBlock(Args&&... args)
+		{
+			new (static_cast<void*>(m_storage)) T(std::forward<Args>(args)...);
+			MemoryTracker::onAllocate<T>(sizeof(TInplaceBlock));
+		}
+
+		T* get() { return reinterpret_cast<T*>(m_storage); }
+
+	protected:
+		~TInplaceBlock() override { MemoryTracker::onFree<T>(sizeof(TInplaceBlock)); }
+
+		void destroyObject() override { get()->~T(); }
+
+	private:
+		alignas(T) unsigned char m_storage[sizeof(T)];
+	};
+
+	/**
+	 * @brief Etiqueta para construir un TSharedPointer que adopta una referencia
+	 * ya contada en el bloque (sin incrementarla).
+	 */
+	struct AdoptRefTag {};
+
+	/**
+	 * @brief Clase TSharedPointer para manejar la gestión de memoria compartida.
 	 *
 	 * La clase TSharedPointer gestiona la memoria de un objeto de tipo T y lleva un
-	 * recuento de referencias para permitir la compartici�n segura de un mismo objeto
-	 * en m�ltiples instancias de TSharedPointer.
+	 * recuento de referencias para permitir la compartición segura de un mismo objeto
+	 * en múltiples instancias de TSharedPointer. El recuento vive en un bloque de
+	 * control (TRefCountBlock) y Policy decide si es atómico.
+	 *
+	 * Un TSharedPointer con bloque nulo y puntero no nulo es una vista sin dueño:
+	 * no cuenta referencias ni destruye el objeto (lo usa Entity para componentes
+	 * guardados en el Registry).
+	 *
+	 * Hilos: con la política por defecto (NonAtomicRefCount) las copias y
+	 * destrucciones de punteros a un mismo objeto no deben ocurrir en varios hilos
+	 * a la vez. Los trabajos del ThreadPool y los sistemas del SystemScheduler
+	 * reciben punteros crudos o referencias (Path, comportamientos, componentes),
+	 * nunca copias. Un objeto cuyos punteros sí se copien desde trabajos debe
+	 * crearse con MakeSharedAtomic<T>() (o compilar con HORCHATA_ATOMIC_REFCOUNT).
 	 */
-	template<typename T>
+	template<typename T, typename Policy = DefaultRefCountPolicy>
 	class TSharedPointer
 	{
 	public:
+		using ControlBlock = TRefCountBlock<Policy>;
+
 		/**
 		 * @brief Constructor por defecto.
 		 *
-		 * Inicializa el puntero y el recuento de referencias a nullptr.
+		 * Inicializa el puntero y el bloque de control a nullptr.
 		 */
-		TSharedPointer() : ptr(nullptr), refCount(nullptr) {}
+		TSharedPointer() : ptr(nullptr), controlBlock(nullptr) {}
 
 		/**
 		 * @brief Constructor que toma un puntero crudo.
 		 *
+		 * Reserva un bloque de control aparte; MakeShared evita esa segunda reserva.
+		 *
 		 * @param rawPtr Puntero crudo al objeto que se va a gestionar.
 		 */
-		explicit TSharedPointer(T* rawPtr) : ptr(rawPtr), refCount(new int(1)) {}
+		explicit TSharedPointer(T* rawPtr)
+			: ptr(rawPtr), controlBlock(rawPtr ? new TPointerBlock<T, Policy>(rawPtr) : nullptr) {}
 
 		/**
-		 * @brief Constructor desde un puntero crudo y un recuento de referencias.
+		 * @brief Constructor desde un puntero crudo y un bloque de control existente.
 		 *
 		 * @param rawPtr Puntero crudo al objeto gestionado.
-		 * @param existingRefCount Puntero al recuento de referencias existente.
+		 * @param existingBlock Bloque de control del objeto, o nullptr para una vista sin dueño.
 		 */
-		TSharedPointer(T* rawPtr, int* existingRefCount) : ptr(rawPtr), refCount(existingRefCount)
+		TSharedPointer(T* rawPtr, ControlBlock* existingBlock) : ptr(rawPtr), controlBlock(existingBlock)
 		{
-			if (refCount)
+			if (controlBlock)
 			{
-				++(*refCount);
+				controlBlock->addStrong();
 			}
 		}
 
+		/**
+		 * @brief Constructor que adopta una referencia ya contada en el bloque.
+		 */
+		TSharedPointer(T* rawPtr, ControlBlock* existingBlock, AdoptRefTag)
+			: ptr(rawPtr), controlBlock(existingBlock) {}
+
 		/**
 		 * @brief Constructor de copia.
 		 *
-		 * Copia el puntero y el recuento de referencias del otro TSharedPointer y
+		 * Copia el puntero y el bloque de control del otro TSharedPointer y
 		 * aumenta el recuento de referencias.
 		 *
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 */
-		TSharedPointer(const TSharedPointer<T>& other) : ptr(other.ptr), refCount(other.refCount)
+		TSharedPointer(const TSharedPointer& other) : ptr(other.ptr), controlBlock(other.controlBlock)
 		{
-			if (refCount)
+			if (controlBlock)
 			{
-				++(*refCount);
+				controlBlock->addStrong();
 			}
 		}
 
 		/**
 		 * @brief Constructor de movimiento.
 		 *
-		 * Transfiere la propiedad del puntero y el recuento de referencias del otro
-		 * TSharedPointer al nuevo objeto TSharedPointer.
+		 * Transfiere la propiedad del puntero y del bloque de control del otro
+		 * TSharedPointer al nuevo objeto TSharedPointer, sin tocar el recuento.
 		 *
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 */
-		TSharedPointer(TSharedPointer<T>&& other) noexcept : ptr(other.ptr), refCount(other.refCount)
+		TSharedPointer(TSharedPointer&& other) noexcept : ptr(other.ptr), controlBlock(other.controlBlock)
+		{
+			other.ptr = nullptr;
+			other.controlBlock = nullptr;
+		}
+
+		/**
+		 * @brief Constructor de conversión desde un TSharedPointer de un tipo derivado.
+		 */
+		template<typename U>
+		TSharedPointer(const TSharedPointer<U, Policy>& other)
+			: ptr(other.ptr), controlBlock(other.controlBlock)
+		{
+			if (controlBlock)
+			{
+				controlBlock->addStrong();
+			}
+		}
+
+		/**
+		 * @brief Constructor de conversión por movimiento desde un tipo derivado.
+		 */
+		template<typename U>
+		TSharedPointer(TSharedPointer<U, Policy>&& other) noexcept
+			: ptr(other.ptr), controlBlock(other.controlBlock)
 		{
 			other.ptr = nullptr;
-			other.refCount = nullptr;
+			other.controlBlock = nullptr;
 		}
 
 		/**
-		 * @brief Operador de asignaci�n de copia.
+		 * @brief Operador de asignación de copia.
 		 *
-		 * Libera el objeto actual, copia el puntero y el recuento de referencias del otro
-		 * TSharedPointer, y aumenta el recuento de referencias.
+		 * Aumenta el recuento del otro objeto antes de liberar el actual, así que
+		 * la autoasignación es segura.
 		 *
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 * @return Referencia al objeto TSharedPointer actual.
 		 */
-		TSharedPointer<T>& operator=(const TSharedPointer<T>& other)
+		TSharedPointer& operator=(const TSharedPointer& other)
 		{
-			if (this != &other)
+			if (other.controlBlock)
 			{
-				// Disminuir el recuento de referencias del objeto actual
-				if (refCount && --(*refCount) == 0)
-				{
-					delete ptr;
-					delete refCount;
-				}
-				// Copiar datos del otro puntero compartido
-				ptr = other.ptr;
-				refCount = other.refCount;
-				if (refCount)
-				{
-					++(*refCount);
-				}
+				other.controlBlock->addStrong();
 			}
+			releaseReference();
+			ptr = other.ptr;
+			controlBlock = other.controlBlock;
 			return *this;
 		}
 
 		/**
-		 * @brief Operador de asignaci�n de movimiento.
+		 * @brief Operador de asignación de movimiento.
 		 *
-		 * Libera el objeto actual, transfiere la propiedad del puntero y el recuento de
-		 * referencias del otro TSharedPointer al actual.
+		 * Libera el objeto actual, transfiere la propiedad del puntero y del bloque de
+		 * control del otro TSharedPointer al actual.
 		 *
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 * @return Referencia al objeto TSharedPointer actual.
 		 */
-		TSharedPointer<T>& operator=(TSharedPointer<T>&& other) noexcept
+		TSharedPointer& operator=(TSharedPointer&& other) noexcept
 		{
 			if (this != &other)
 			{
-				// Liberar el objeto actual
-				if (refCount && --(*refCount) == 0)
-				{
-					delete ptr;
-					delete refCount;
-				}
-				// Transferir los datos del otro puntero compartido
+				releaseReference();
 				ptr = other.ptr;
-				refCount = other.refCount;
+				controlBlock = other.controlBlock;
 				other.ptr = nullptr;
-				other.refCount = nullptr;
+				other.controlBlock = nullptr;
 			}
 			return *this;
 		}
 
-		template<typename U>
-		TSharedPointer(const TSharedPointer<U>& other)
-			: ptr(other.ptr), refCount(other.refCount)
-		{
-			if (refCount) ++(*refCount);
-		}
-
 		/**
 		 * @brief Destructor.
 		 *
@@ -171,15 +407,11 @@ namespace EngineUtilities {
 		 */
 		~TSharedPointer()
 		{
-			if (refCount && --(*refCount) == 0)
-			{
-				delete ptr;
-				delete refCount;
-			}
+			releaseReference();
 		}
 
 		/**
-		 * @brief Operador de desreferenciaci�n.
+		 * @brief Operador de desreferenciación.
 		 *
 		 * @return Referencia al objeto gestionado.
 		 */
@@ -192,7 +424,7 @@ namespace EngineUtilities {
 		 */
 		T* operator->() const { return ptr; }
 
-		// Agregar una funci�n para comprobar si el puntero es v�lido
+		// Agregar una función para comprobar si el puntero es válido
 		operator bool() const {
 			return ptr != nullptr;
 		}
@@ -211,76 +443,84 @@ namespace EngineUtilities {
 		 */
 		bool isNull() const { return ptr == nullptr; }
 
+		/**
+		 * @brief Número de TSharedPointer que comparten el objeto (0 para nulos y vistas).
+		 */
+		int useCount() const { return controlBlock ? controlBlock->strongCount() : 0; }
+
 	public:
-		T* ptr;       ///< Puntero al objeto gestionado.
-		int* refCount; ///< Puntero al recuento de referencias.
+		T* ptr;                     ///< Puntero al objeto gestionado.
+		ControlBlock* controlBlock; ///< Bloque con el recuento de referencias.
 
 		/**
-		 * @brief M�todo swap.
+		 * @brief Método swap.
 		 *
 		 * Intercambia los datos de dos objetos TSharedPointer.
 		 *
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 */
-		void swap(TSharedPointer<T>& other) noexcept
+		void swap(TSharedPointer& other) noexcept
 		{
-			T* tempPtr = other.ptr;
-			int* tempRefCount = other.refCount;
-
-			other.ptr = this->ptr;
-			other.refCount = this->refCount;
-
-			this->ptr = tempPtr;
-			this->refCount = tempRefCount;
+			std::swap(ptr, other.ptr);
+			std::swap(controlBlock, other.controlBlock);
 		}
 
 		/**
-				 * @brief Libera el objeto actual y opcionalmente asigna un nuevo objeto.
-				 *
-				 * @param newPtr Nuevo puntero crudo al objeto que se va a gestionar (por defecto es nullptr).
-				 */
+		 * @brief Libera el objeto actual y opcionalmente asigna un nuevo objeto.
+		 *
+		 * @param newPtr Nuevo puntero crudo al objeto que se va a gestionar (por defecto es nullptr).
+		 */
 		void reset(T* newPtr = nullptr)
 		{
-			// Disminuir el recuento de referencias del objeto actual
-			if (refCount && --(*refCount) == 0)
-			{
-				delete ptr;
-				delete refCount;
-			}
-
-			// Si newPtr es nullptr, asignar nullptr al puntero y recuento de referencias
-			if (newPtr == nullptr)
-			{
-				ptr = nullptr;
-				refCount = nullptr;
-			}
-			else
-			{
-				// Asignar nuevo objeto y manejar el recuento de referencias
-				ptr = newPtr;
-				refCount = new int(1);
-			}
+			TSharedPointer(newPtr).swap(*this);
 		}
 
-		// M�todo de conversi�n para hacer cast din�mico
+		// Método de conversión para hacer cast dinámico
 		template<typename U>
-		TSharedPointer<U> dynamic_pointer_cast() const {
+		TSharedPointer<U, Policy> dynamic_pointer_cast() const {
 			// Intenta convertir el puntero de tipo T a U
 			U* castedPtr = dynamic_cast<U*>(ptr);
 			if (castedPtr) {
-				// Si la conversi�n es exitosa, devuelve un nuevo TSharedPointer<U>
-				return TSharedPointer<U>(castedPtr, refCount);
+				// Si la conversión es exitosa, comparte el bloque de control
+				return TSharedPointer<U, Policy>(castedPtr, controlBlock);
 			}
 			else {
-				// Si falla la conversi�n, devuelve un TSharedPointer<U> nulo
-				return TSharedPointer<U>();
+				// Si falla la conversión, devuelve un TSharedPointer<U> nulo
+				return TSharedPointer<U, Policy>();
 			}
 		}
 
+	private:
+		/**
+		 * @brief Suelta la referencia actual, si la hay.
+		 */
+		void releaseReference()
+		{
+			if (controlBlock)
+			{
+				controlBlock->releaseStrong();
+			}
+		}
 	};
 
 	/**
-	 * @brief Funci�n de utilidad para crear un TSharedPointer.
+	 * @brief Crea un objeto y su bloque de control en una sola reserva.
+	 *
+	 * @tparam T Tipo del objeto gestionado.
+	 * @tparam Policy Política de recuento del puntero.
+	 * @param args Argumentos del constructor, reenviados sin copias.
+	 */
+	template<typename T, typename Policy, typename... Args>
+	TSharedPointer<T, Policy> MakeSharedWithPolicy(Args&&... args)
+	{
+		auto* block = new TInplaceBlock<T, Policy>(std::forward<Args>(args)...);
+		return TSharedPointer<T, Policy>(block->get(), block, AdoptRefTag{});
+	}
+
+	/**
+	 * @brief Función de utilidad para crear un TSharedPointer.
+	 *
+	 * El objeto y su recuento comparten una única reserva de memoria.
 	 *
 	 * @tparam T Tipo del objeto gestionado.
 	 * @tparam Args Tipos de los argumentos del constructor del objeto gestionado.
@@ -288,9 +528,19 @@ namespace EngineUtilities {
 	 * @return Un objeto TSharedPointer gestionando un nuevo objeto de tipo T.
 	 */
 	template<typename T, typename... Args>
-	TSharedPointer<T> MakeShared(Args... args)
+	TSharedPointer<T> MakeShared(Args&&... args)
+	{
+		return MakeSharedWithPolicy<T, DefaultRefCountPolicy>(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Igual que MakeShared, pero con recuento atómico para compartir el
+	 * objeto entre hilos.
+	 */
+	template<typename T, typename... Args>
+	TSharedPointer<T, AtomicRefCount> MakeSharedAtomic(Args&&... args)
 	{
-		return TSharedPointer<T>(new T(args...));
+		return MakeSharedWithPolicy<T, AtomicRefCount>(std::forward<Args>(args)...);
 	}
 
 }
\ No newline at end of file
@@ -27,6 +27,8 @@
  * SOFTWARE.
 */
 #pragma once
+#include <utility>
+#include "MemoryTracker.h"
 
 namespace EngineUtilities {
   /**
@@ -52,7 +54,10 @@ namespace EngineUtilities {
      *
      * @param rawPtr Puntero crudo al objeto que se va a gestionar.
      */
-    explicit TUniquePtr(T* rawPtr) : ptr(rawPtr) {}
+    explicit TUniquePtr(T* rawPtr) : ptr(rawPtr)
+    {
+      track(ptr);
+    }
 
     /**
      * @brief Constructor de movimiento.
@@ -80,6 +85,7 @@ namespace EngineUtilities {
       if (this != &other)
       {
         // Liberar el objeto actual
+        untrack(ptr);
         delete ptr;
 
         // Transferir los datos del otro puntero exclusivo
@@ -96,6 +102,7 @@ namespace EngineUtilities {
      */
     ~TUniquePtr()
     {
+      untrack(ptr);
       delete ptr;
     }
 
@@ -106,6 +113,7 @@ namespace EngineUtilities {
     template<typename U>
     TUniquePtr(TUniquePtr<U>&& other) noexcept
       : ptr(static_cast<T*>(other.release())) {
+      track(ptr);
     }
 
 
@@ -140,6 +148,7 @@ namespace EngineUtilities {
     T* release()
     {
       T* oldPtr = ptr;
+      untrack(ptr);
       ptr = nullptr;
       return oldPtr;
     }
@@ -153,8 +162,10 @@ namespace EngineUtilities {
      */
     void reset(T* rawPtr = nullptr)
     {
+      untrack(ptr);
       delete ptr;
       ptr = rawPtr;
+      track(ptr);
     }
 
     /**
@@ -167,6 +178,28 @@ namespace EngineUtilities {
       return ptr == nullptr;
     }
   private:
+    /**
+     * @brief Registrar en el MemoryTracker un objeto que pasa a ser propiedad del puntero.
+     */
+    static void track(T* object)
+    {
+      if (object)
+      {
+        MemoryTracker::onAllocate<T>(sizeof(T));
+      }
+    }
+
+    /**
+     * @brief Registrar en el MemoryTracker un objeto que deja de ser propiedad del puntero.
+     */
+    static void untrack(T* object)
+    {
+      if (object)
+      {
+        MemoryTracker::onFree<T>(sizeof(T));
+      }
+    }
+
     T* ptr; ///< Puntero al objeto gestionado.
   };
 
@@ -179,9 +212,9 @@ namespace EngineUtilities {
    * @return Un objeto TUniquePtr gestionando un nuevo objeto de tipo T.
    */
   template<typename T, typename... Args>
-  TUniquePtr<T> MakeUnique(Args... args)
+  TUniquePtr<T> MakeUnique(Args&&... args)
   {
-    return TUniquePtr<T>(new T(args...));
+    return TUniquePtr<T>(new T(std::forward<Args>(args)...));
   }
 
 
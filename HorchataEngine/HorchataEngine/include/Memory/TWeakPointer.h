@@ -1,4 +1,4 @@
-/*
+﻿/*
  * MIT License
  *
  * Copyright (c) 2024 Roberto Charreton
@@ -35,46 +35,91 @@ namespace EngineUtilities {
 		 *
 		 * La clase TWeakPointer proporciona una manera de observar un objeto gestionado por un TSharedPointer
 		 * sin tener influencia sobre el recuento de referencias del objeto. Permite acceder al objeto solo si
-		 * an existe.
+		 * aún existe.
 		 */
-	template<typename T>
+	template<typename T, typename Policy = DefaultRefCountPolicy>
 	class TWeakPointer
 	{
 	public:
 		/**
 		 * @brief Constructor por defecto.
 		 */
-		TWeakPointer() : ptr(nullptr), refCount(nullptr) {}
+		TWeakPointer() : ptr(nullptr), controlBlock(nullptr) {}
 
 		/**
 		 * @brief Constructor que toma un TSharedPointer.
 		 *
-		 * @param sharedPtr TSharedPointer desde el cual se observar el objeto.
+		 * Toma una referencia débil: el bloque de control sigue vivo aunque el objeto
+		 * se destruya, así que lock() siempre puede comprobarlo sin riesgo.
+		 *
+		 * @param sharedPtr TSharedPointer desde el cual se observará el objeto.
 		 */
-		TWeakPointer(const TSharedPointer<T>& sharedPtr) 
-		: ptr(sharedPtr.ptr), refCount(sharedPtr.refCount) {}
+		TWeakPointer(const TSharedPointer<T, Policy>& sharedPtr)
+		: ptr(sharedPtr.ptr), controlBlock(sharedPtr.controlBlock)
+		{
+			if (controlBlock)
+			{
+				controlBlock->addWeak();
+			}
+		}
+
+		TWeakPointer(const TWeakPointer& other) : ptr(other.ptr), controlBlock(other.controlBlock)
+		{
+			if (controlBlock)
+			{
+				controlBlock->addWeak();
+			}
+		}
+
+		TWeakPointer(TWeakPointer&& other) noexcept : ptr(other.ptr), controlBlock(other.controlBlock)
+		{
+			other.ptr = nullptr;
+			other.controlBlock = nullptr;
+		}
+
+		TWeakPointer& operator=(TWeakPointer other) noexcept
+		{
+			std::swap(ptr, other.ptr);
+			std::swap(controlBlock, other.controlBlock);
+			return *this;
+		}
+
+		/**
+		 * @brief Destructor. Suelta la referencia débil.
+		 */
+		~TWeakPointer()
+		{
+			if (controlBlock)
+			{
+				controlBlock->releaseWeak();
+			}
+		}
 
 		/**
 		 * @brief Convertir TWeakPointer a TSharedPointer.
 		 *
 		 * @return Un TSharedPointer al objeto gestionado, o nullptr si el objeto ha sido destruido.
 		 */
-		TSharedPointer<T> lock() const
+		TSharedPointer<T, Policy> lock() const
 		{
-			if (refCount && *refCount > 0)
+			if (controlBlock && controlBlock->tryAddStrong())
 			{
-				return TSharedPointer<T>(ptr, refCount);
+				return TSharedPointer<T, Policy>(ptr, controlBlock, AdoptRefTag{});
 			}
-			return TSharedPointer<T>();
+			return TSharedPointer<T, Policy>();
 		}
 
-		// Hacer que TSharedPointer sea un amigo para acceder a los miembros privados.
-		template<typename U>
-		friend class TSharedPointer;
+		/**
+		 * @brief Comprobar si el objeto observado ya fue destruido.
+		 */
+		bool expired() const
+		{
+			return !controlBlock || controlBlock->strongCount() == 0;
+		}
 
 	private:
-		T* ptr;       ///< Puntero al objeto observado.
-		int* refCount; ///< Puntero al recuento de referencias del TSharedPointer original.
+		T* ptr;                                            ///< Puntero al objeto observado.
+		typename TSharedPointer<T, Policy>::ControlBlock* controlBlock; ///< Bloque de control del TSharedPointer original.
 	};
 
 	/*
@@ -105,7 +150,7 @@ int main()
 				EngineUtilities::TSharedPointer<MyClass> sp2 = wp1.lock();
 				if (!sp2.isNull())
 				{
-						sp2->display(); // Debera mostrar el valor 10
+						sp2->display(); // Debería mostrar el valor 10
 				}
 				else
 				{
@@ -116,23 +161,23 @@ int main()
 				EngineUtilities::TSharedPointer<MyClass> sp3 = EngineUtilities::MakeShared<MyClass>(20);
 				sp3 = std::move(sp1); // Mueve la propiedad de sp1 a sp3
 
-				// El puntero compartido original (sp1) ahora est vaco
+				// El puntero compartido original (sp1) ahora está vacío
 				EngineUtilities::TSharedPointer<MyClass> sp4 = wp1.lock();
 				if (sp4.isNull())
 				{
 						std::cout << "sp1 has been moved and is now null." << std::endl;
 				}
 
-				// Intentar obtener un TSharedPointer despus del movimiento
+				// Intentar obtener un TSharedPointer después del movimiento
 				if (sp3.isNull())
 				{
 						std::cout << "sp3 is null." << std::endl;
 				}
 				else
 				{
-						sp3->display(); // Debera mostrar el valor 20
+						sp3->display(); // Debería mostrar el valor 20
 				}
-		} // Aqu, tanto sp2 como sp4 se destruyen y la memoria de MyClass se libera automticamente
+		} // Aquí, tanto sp2 como sp4 se destruyen y la memoria de MyClass se libera automáticamente
 
 		return 0;
 }
@@ -0,0 +1,127 @@
+#pragma once
+#include "Prerequisites.h"
+
+/**
+ * @brief Closest point of a Path to a position.
+ */
+struct PathProjection {
+  EngineMath::Vector2 point; /**< Closest point on the path. */
+  float distance = 0.f;      /**< Arc length from the first point to the closest point. */
+  float distanceSq = 0.f;    /**< Squared distance from the position to the closest point. */
+  size_t segment = 0;        /**< Segment that holds the closest point, from point segment to segment + 1. */
+};
+
+/**
+ * @class Path
+ * @brief Read-only polyline with its arc length precomputed, shared by everything that follows it.
+ *
+ * Segment lengths and the cumulative arc length are computed once, so queries
+ * only need dot products: projecting a position gives its progress along the
+ * path as a single float. A closed path joins the last point back to the first.
+ * There is no way to change a Path once built; share it through a TSharedPointer.
+ */
+class
+  Path {
+public:
+  /**
+   * @brief Builds the path and its arc length table.
+   * @param points Points of the path, at least two.
+   * @param closed Joins the last point to the first (a lap).
+   */
+  explicit Path(std::vector<EngineMath::Vector2> points, bool closed = true);
+
+  /**
+   * @brief Gets the closest point of the path to a position, checking every segment.
+   */
+  PathProjection
+    project(const EngineMath::Vector2& position) const;
+
+  /**
+   * @brief Gets the closest point of the path to a position, checking only the
+   * segments around a hint (e.g. the segment of the last frame).
+   * @param position Position to project.
+   * @param hintSegment Segment to start from.
+   * @param searchRadius Segments checked before and after the hint.
+   */
+  PathProjection
+    project(const EngineMath::Vector2& position, size_t hintSegment, size_t searchRadius = 2) const;
+
+  /**
+   * @brief Gets the point at an arc length. Closed paths wrap around, open paths clamp.
+   */
+  EngineMath::Vector2
+    pointAtDistance(float distance) const;
+
+  /**
+   * @brief Gets the segment that holds an arc length (binary search).
+   */
+  size_t
+    segmentAtDistance(float distance) const;
+
+  /**
+   * @brief Brings an arc length into [0, length) on closed paths, clamps it on open ones.
+   */
+  float
+    wrapDistance(float distance) const;
+
+  const std::vector<EngineMath::Vector2>&
+    getPoints() const {
+    return m_points;
+  }
+
+  const EngineMath::Vector2&
+    getPoint(size_t index) const {
+    return m_points[index];
+  }
+
+  size_t
+    getPointCount() const {
+    return m_points.size();
+  }
+
+  size_t
+    getSegmentCount() const {
+    return m_segmentLengths.size();
+  }
+
+  float
+    getSegmentLength(size_t segment) const {
+    return m_segmentLengths[segment];
+  }
+
+  /**
+   * @brief Gets the arc length from the first point to a point.
+   * On closed paths getDistanceAt(getPointCount()) is the length of the lap.
+   */
+  float
+    getDistanceAt(size_t point) const {
+    return m_cumulativeLengths[point];
+  }
+
+  /**
+   * @brief Gets the total arc length (one lap on closed paths).
+   */
+  float
+    getLength() const {
+    return m_cumulativeLengths.back();
+  }
+
+  bool
+    isClosed() const {
+    return m_closed;
+  }
+
+private:
+  /**
+   * @brief Projects a position onto one segment.
+   */
+  void
+    projectOnSegment(const EngineMath::Vector2& position, size_t segment, PathProjection& best) const;
+
+  std::vector<EngineMath::Vector2> m_points;
+  std::vector<EngineMath::Vector2> m_segmentDeltas; /**< End minus start of every segment. */
+  std::vector<float> m_segmentLengths;
+  std::vector<float> m_segmentInvLengthsSq;         /**< 1 / length^2, 0 for empty segments. */
+  std::vector<float> m_cumulativeLengths;           /**< Arc length at every point, plus the lap length on closed paths. */
+  bool m_closed = true;
+};
@@ -11,15 +11,19 @@
 #include <map>
 #include <fstream>
 #include <unordered_map>
+#include <atomic>
+#include <type_traits>
 
 // ============================================================================
 // Third-Party Libraries
 // ============================================================================
 #include <SFML/Graphics.hpp>
-#include "Memory/TsharedPointer.h"
+#include "Memory/TSharedPointer.h"
 #include "Memory/TWeakPointer.h"
 #include "Memory/TStaticPtr.h"
 #include "Memory/TUniquePtr.h"
+#include "Memory/TPoolAllocator.h"
+#include "Memory/TFrameArena.h"
 #include "Utilities/Utilities/EngineMath.h"
 #include "Utilities/Vectors/Quaternion.h"
 #include "Utilities/Vectors/Vector2.h"
@@ -28,6 +32,7 @@
 #include "Utilities/Matrix/Matrix2x2.h"
 #include "Utilities/Matrix/Matrix3x3.h"
 #include "Utilities/Matrix/Matrix4x4.h"
+#include "Utilities/Vectors/VectorBatch.h"
 
 // ============================================================================
 // Imgui-SFML
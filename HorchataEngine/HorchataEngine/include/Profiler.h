@@ -0,0 +1,274 @@
+#pragma once
+#include "Prerequisites.h"
+#include <chrono>
+#include <mutex>
+#include <unordered_set>
+
+/**
+ * @brief Set to 0 to compile every profiling zone out of the engine.
+ */
+#ifndef HORCHATA_PROFILER
+#define HORCHATA_PROFILER 1
+#endif
+
+/**
+ * @brief One timed zone, recorded when its scope ends.
+ */
+struct ProfileZone {
+  const char* name = nullptr; /**< Zone name, must outlive the profiler (literal or interned). */
+  uint64_t start = 0;         /**< Start time in nanoseconds (Profiler::now). */
+  uint64_t end = 0;           /**< End time in nanoseconds. */
+  uint32_t depth = 0;         /**< Nesting level inside the thread, 0 for outermost zones. */
+  uint32_t threadId = 0;      /**< Profiler id of the thread that recorded the zone. */
+};
+
+/**
+ * @class Profiler
+ * @brief CPU frame profiler with scoped zones and per-thread ring buffers.
+ *
+ * Every thread writes the zones it closes into its own ring buffer, so threads
+ * never wait on each other while recording; the ring keeps the most recent
+ * zones and overwrites the oldest. endFrame() gathers the zones of the frame
+ * for the GUI, and exportChromeTrace() writes everything still in the rings as
+ * a trace for chrome://tracing or Perfetto.
+ * A disabled profiler costs one relaxed atomic load per zone; building with
+ * HORCHATA_PROFILER=0 removes the zones entirely.
+ */
+class
+  Profiler {
+private:
+  Profiler();
+  ~Profiler() = default;
+
+public:
+  Profiler(const Profiler&) = delete;
+  Profiler& operator=(const Profiler&) = delete;
+
+  /**
+   * @brief Zones kept per thread before the oldest are overwritten.
+   */
+  static constexpr size_t RING_CAPACITY = 1 << 15;
+
+  /**
+   * @brief Frames kept in the frame time history.
+   */
+  static constexpr size_t FRAME_HISTORY = 300;
+
+  /**
+   * @brief Gets the global profiler.
+   */
+  static Profiler&
+    getInstance() {
+    static Profiler instance;
+    return instance;
+  }
+
+  /**
+   * @brief Gets the current time in nanoseconds (steady clock).
+   */
+  static uint64_t
+    now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  /**
+   * @brief Starts or stops recording zones. Frame times are always recorded.
+   * While stopped, the zones of the last recorded frame stay available.
+   */
+  void
+    setEnabled(bool enabled) {
+    m_enabled.store(enabled, std::memory_order_relaxed);
+  }
+
+  bool
+    isEnabled() const {
+    return m_enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Names the calling thread in the GUI and in exported traces.
+   */
+  void
+    setThreadName(const std::string& name);
+
+  /**
+   * @brief Gets a stable copy of a name, for zones named at runtime.
+   * @return Pointer valid for the lifetime of the profiler.
+   */
+  const char*
+    internName(const std::string& name);
+
+  /**
+   * @brief Opens a zone on the calling thread. Use PROFILE_SCOPE instead.
+   * @return Depth of the new zone.
+   */
+  uint32_t
+    enterZone();
+
+  /**
+   * @brief Closes the zone opened by the matching enterZone and records it.
+   */
+  void
+    leaveZone(const char* name, uint64_t start, uint32_t depth);
+
+  /**
+   * @brief Marks the start of a frame.
+   */
+  void
+    beginFrame();
+
+  /**
+   * @brief Marks the end of a frame: stores its duration and gathers its zones.
+   */
+  void
+    endFrame();
+
+  /**
+   * @brief Gets the zones of the last recorded frame, sorted by thread, start and depth.
+   */
+  const std::vector<ProfileZone>&
+    getFrameZones() const {
+    return m_frameZones;
+  }
+
+  /**
+   * @brief Gets the start time of the last recorded frame.
+   */
+  uint64_t
+    getFrameStart() const {
+    return m_frameZonesStart;
+  }
+
+  /**
+   * @brief Gets the end time of the last recorded frame.
+   */
+  uint64_t
+    getFrameEnd() const {
+    return m_frameZonesEnd;
+  }
+
+  /**
+   * @brief Gets the frame time history in milliseconds, a ring of FRAME_HISTORY values.
+   * getFrameHistoryOffset() is the index of the oldest one.
+   */
+  const std::vector<float>&
+    getFrameHistory() const {
+    return m_frameHistory;
+  }
+
+  size_t
+    getFrameHistoryOffset() const {
+    return m_frameHistoryIndex;
+  }
+
+  /**
+   * @brief Gets the name of a thread by profiler id.
+   */
+  std::string
+    getThreadName(uint32_t threadId);
+
+  /**
+   * @brief Writes the zones still in the ring buffers in Chrome trace event format (JSON).
+   * @return True if the file was written.
+   */
+  bool
+    exportChromeTrace(const std::string& fileName);
+
+private:
+  /**
+   * @brief Ring of zones written by one thread.
+   * The mutex is only contended while endFrame or an export reads the ring.
+   */
+  struct ThreadBuffer {
+    std::mutex mutex;
+    std::vector<ProfileZone> zones;
+    uint64_t written = 0;   /**< Zones ever written, the ring index is written % RING_CAPACITY. */
+    uint64_t collected = 0; /**< Zones already gathered by endFrame. */
+    uint32_t depth = 0;     /**< Zones currently open on the thread. */
+    uint32_t id = 0;
+    std::string name;
+  };
+
+  /**
+   * @brief Gets the buffer of the calling thread, creating it on first use.
+   */
+  ThreadBuffer&
+    threadBuffer();
+
+  static thread_local ThreadBuffer* t_threadBuffer; /**< Buffer of the calling thread, null until its first zone. */
+
+  std::atomic<bool> m_enabled{ true };
+  std::mutex m_mutex; /**< Guards the buffer list and the interned names. */
+  std::vector<EngineUtilities::TUniquePtr<ThreadBuffer>> m_buffers;
+  std::unordered_set<std::string> m_names;
+
+  uint64_t m_epoch = 0;      /**< Time origin of exported traces. */
+  uint64_t m_frameStart = 0;
+  std::vector<ProfileZone> m_frameZones;
+  uint64_t m_frameZonesStart = 0;
+  uint64_t m_frameZonesEnd = 0;
+  std::vector<float> m_frameHistory;
+  size_t m_frameHistoryIndex = 0;
+};
+
+/**
+ * @class ProfileScope
+ * @brief Times the scope it lives in as a profiler zone.
+ */
+class
+  ProfileScope {
+public:
+  /**
+   * @brief Opens the zone if the profiler is recording.
+   * @param name Zone name, must outlive the profiler (literal or Profiler::internName).
+   */
+  explicit ProfileScope(const char* name) {
+    Profiler& profiler = Profiler::getInstance();
+    if (profiler.isEnabled()) {
+      m_name = name;
+      m_depth = profiler.enterZone();
+      m_start = Profiler::now();
+    }
+  }
+
+  /**
+   * @brief Closes and records the zone.
+   */
+  ~ProfileScope() {
+    if (m_name) {
+      Profiler::getInstance().leaveZone(m_name, m_start, m_depth);
+    }
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+  const char* m_name = nullptr;
+  uint64_t m_start = 0;
+  uint32_t m_depth = 0;
+};
+
+// ============================================================================
+// Profiling macros
+// ============================================================================
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#if HORCHATA_PROFILER
+/**
+ * @brief Times the rest of the enclosing scope as a zone with the given name.
+ * @param name String literal or interned name.
+ */
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+/**
+ * @brief Times the rest of the enclosing function as a zone named after it.
+ */
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#endif
@@ -0,0 +1,101 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Path.h"
+#include <algorithm>
+
+/**
+ * @class RaceProgress
+ * @brief Continuous race progress (laps plus the fraction of the current lap) of every kart.
+ *
+ * One batched pass projects every position onto the Path, searching only
+ * around the segment of the last frame, and counts a lap each time a kart
+ * crosses the first point of the path. Crossing it backwards takes the lap
+ * back, so driving in circles over the line does not add laps.
+ * Karts spawn on the grid behind the start: a participant first seen in the
+ * second half of the lap starts at lap -1, so crossing the start begins lap 0
+ * instead of completing one.
+ * Waypoint index, lap count and ranking are all read from here, so nothing
+ * else has to measure distances to waypoints.
+ */
+class
+  RaceProgress {
+public:
+  /**
+   * @brief Sets the number of participants. New participants are placed on
+   * their first update, with no lap counted.
+   */
+  void
+    resize(size_t participants);
+
+  /**
+   * @brief Updates every participant from its position.
+   * @param path Path the race follows, closed.
+   * @param positions One position per participant.
+   */
+  void
+    update(const Path& path, const std::vector<EngineMath::Vector2>& positions);
+
+  /**
+   * @brief Gets the progress of a participant: completed laps plus the fraction of the current lap.
+   * Negative while the participant has not crossed the start yet.
+   */
+  float
+    getProgress(size_t participant) const {
+    return m_progress[participant];
+  }
+
+  /**
+   * @brief Gets the number of laps a participant completed. 0 until it first crosses the start.
+   */
+  int
+    getLap(size_t participant) const {
+    return std::max(m_laps[participant], 0);
+  }
+
+  /**
+   * @brief Gets the arc length of a participant within the current lap.
+   */
+  float
+    getLapDistance(size_t participant) const {
+    return m_lapDistances[participant];
+  }
+
+  /**
+   * @brief Gets the segment of the path the participant is on.
+   */
+  size_t
+    getSegment(size_t participant) const {
+    return m_segments[participant];
+  }
+
+  /**
+   * @brief Gets the waypoint a participant is heading to, the end of its segment.
+   */
+  size_t
+    getNextWaypoint(size_t participant, const Path& path) const {
+    return (m_segments[participant] + 1) % path.getPointCount();
+  }
+
+  size_t
+    size() const {
+    return m_progress.size();
+  }
+
+  /**
+   * @brief Participants updated per ThreadPool job; smaller fields run on the calling thread.
+   */
+  static constexpr size_t GRAIN_SIZE = 1024;
+
+private:
+  /**
+   * @brief Updates the participants in [begin, end).
+   */
+  void
+    updateRange(const Path& path, const std::vector<EngineMath::Vector2>& positions, size_t begin, size_t end);
+
+  std::vector<float> m_progress;
+  std::vector<float> m_lapDistances;
+  std::vector<int> m_laps;
+  std::vector<uint32_t> m_segments;
+  std::vector<uint8_t> m_placed; /**< 0 until the first update, which searches the whole path. */
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include "Prerequisites.h"
+
+class Actor;
+
+/**
+ * @class RaceRanking
+ * @brief Race positions kept sorted from frame to frame.
+ *
+ * Each participant has a fixed index (the player is 0, racer i is i + 1) and a
+ * progress value, higher is further ahead (see RaceProgress). Progress changes
+ * little from one frame to the next, so last frame's order is almost right:
+ * update() repairs it with an insertion pass that only moves the participants
+ * that overtook or fell back.
+ * Equal progress keeps the previous order, so positions do not flicker.
+ * Nothing is allocated while the number of participants stays the same.
+ */
+class
+  RaceRanking {
+public:
+  /**
+   * @brief One place of the leaderboard.
+   */
+  struct Entry {
+    const Actor* actor = nullptr; /**< Participant, not owned. */
+    float progress = 0.f;         /**< Laps plus the fraction of the current lap. */
+    uint32_t participant = 0;     /**< Index given to setProgress. */
+  };
+
+  /**
+   * @brief Sets the number of participants. Existing places are kept, new
+   * participants start at the back. Only allocates when the count grows.
+   */
+  void
+    resize(size_t participants);
+
+  /**
+   * @brief Records the progress of a participant. The order is fixed by update().
+   * @param participant Index below the size given to resize.
+   * @param actor Actor shown in the leaderboard.
+   * @param progress Higher is further ahead.
+   */
+  void
+    setProgress(size_t participant, const Actor* actor, float progress) {
+    Entry& entry = m_entries[m_places[participant]];
+    entry.actor = actor;
+    if (entry.progress != progress) {
+      entry.progress = progress;
+      m_dirty = true;
+    }
+  }
+
+  /**
+   * @brief Restores the order after progress changes.
+   * @return Number of places that changed hands.
+   */
+  size_t
+    update();
+
+  /**
+   * @brief Gets the leaderboard, first place first. The rank of entries[i] is i + 1.
+   */
+  const std::vector<Entry>&
+    getEntries() const {
+    return m_entries;
+  }
+
+  /**
+   * @brief Gets the rank (1 is first) of a participant.
+   */
+  size_t
+    getRank(size_t participant) const {
+    return m_places[participant] + 1;
+  }
+
+  size_t
+    size() const {
+    return m_entries.size();
+  }
+
+private:
+  std::vector<Entry> m_entries;   /**< Sorted by progress, highest first. */
+  std::vector<uint32_t> m_places; /**< Index in m_entries of every participant. */
+  bool m_dirty = false;
+};
@@ -1,11 +1,29 @@
 #pragma once
 #include "Prerequisites.h"
 #include "ECS/Texture.h"
+#include "Threading/ThreadPool.h"
+#include "TextureAtlas.h"
+#include "ResourceTable.h"
+#include <mutex>
+
+/**
+ * @brief Default number of bytes of texture data uploaded to the GPU per frame.
+ */
+constexpr size_t DEFAULT_UPLOAD_BUDGET = 8 * 1024 * 1024;
+
+/**
+ * @brief Default limit of resident texture memory before unused textures are evicted.
+ */
+constexpr size_t DEFAULT_TEXTURE_BUDGET = 256 * 1024 * 1024;
 
 class ResourceManager {
 private:
     ResourceManager() = default;
-		~ResourceManager() = default;
+
+    /**
+     * @brief Waits for the decode jobs still running, they write into the manager.
+     */
+		~ResourceManager();
 
 public:
 		ResourceManager(const ResourceManager&) = delete;
@@ -16,11 +34,176 @@ public:
         return instance;
 		}
     
+    /**
+     * @brief Loads a texture synchronously on the calling thread.
+     * @return True if the file could be loaded.
+     */
     bool
       loadTexture(const std::string& fileName, const std::string& extension);
 
+    /**
+     * @brief Starts loading a texture without blocking.
+     * The file is decoded into an sf::Image on the ThreadPool; the returned texture
+     * shows a placeholder until processUploads sends the image to the GPU.
+     * @return The texture, usable right away as a handle (see Texture::getState).
+     */
+    EngineUtilities::TSharedPointer<Texture>
+      loadTextureAsync(const std::string& fileName, const std::string& extension);
+
+    /**
+     * @brief Gets a handle to a texture, starting an async load if it is not resident.
+     * Hashes the name: call at load time and keep the handle.
+     */
+    TextureHandle
+      acquireTexture(const std::string& fileName, const std::string& extension);
+
+    /**
+     * @brief Resolves a handle without any string hashing and marks the texture as used.
+     * @return The texture, or an empty pointer if it was evicted (acquire it again).
+     */
+    EngineUtilities::TSharedPointer<Texture>
+      getTexture(TextureHandle handle) {
+      return m_textures.get(handle);
+    }
+
+    /**
+     * @brief Marks a texture as used this frame, so eviction drops it last.
+     * Shapes call it every time they are drawn.
+     */
+    void
+      touchTexture(TextureHandle handle) {
+      m_textures.touch(handle);
+    }
+
+    /**
+     * @brief Checks if a handle still refers to a resident texture.
+     */
+    bool
+      isValid(TextureHandle handle) const {
+      return m_textures.isValid(handle);
+    }
+
+    /**
+     * @brief Sets the resident texture memory allowed before eviction starts.
+     * Textures referenced by anything besides the manager are never evicted.
+     */
+    void
+      setMemoryBudget(size_t bytes) {
+      m_memoryBudget = bytes;
+    }
+
+    size_t
+      getMemoryBudget() const {
+      return m_memoryBudget;
+    }
+
+    /**
+     * @brief Gets the bytes of every resident texture (width * height * 4 each).
+     */
+    size_t
+      getResidentBytes() const {
+      return m_textures.getResidentBytes();
+    }
+
+    size_t
+      getTextureCount() const {
+      return m_textures.size();
+    }
+
+    /**
+     * @brief Uploads decoded images to their textures. Call once per frame on the main thread.
+     * At least one image is uploaded per call, then uploads stop once the budget is spent.
+     * Afterwards unreferenced textures are evicted, least recently used first, down to the
+     * memory budget.
+     * @param byteBudget Bytes of pixel data allowed this call.
+     * @return Number of textures uploaded (or marked failed).
+     */
+    size_t
+      processUploads(size_t byteBudget = DEFAULT_UPLOAD_BUDGET);
+
+    /**
+     * @brief Blocks until every async load is decoded and uploaded (loading screens, tests).
+     */
+    void
+      waitForLoads();
+
+    /**
+     * @brief Checks if async loads are still decoding or waiting for upload.
+     */
+    bool
+      isLoading();
+
+    /**
+     * @brief Decodes a set of textures and packs the small ones into shared atlas pages.
+     * Decoding runs in parallel on the ThreadPool; the call blocks until the pages are
+     * uploaded. Textures too big for a page are loaded as standalone textures.
+     * @param fileNames Texture files, without extension.
+     * @param extension Extension of every file.
+     * @param cacheFile Manifest of the disk cache; empty disables the cache. A cache built
+     *        from the same files (path, size and write time) is loaded instead of repacking.
+     * @return True if every texture could be loaded.
+     */
+    bool
+      buildAtlas(const std::vector<std::string>& fileNames,
+                 const std::string& extension,
+                 const std::string& cacheFile = "");
+
+    /**
+     * @brief Gets the region of a texture: its atlas page and rect if it was packed,
+     * otherwise the whole standalone texture. The region carries the handle of the
+     * texture (or page), so the shape that shows it keeps it marked as used.
+     */
+    TextureRegion
+      getTextureRegion(const std::string& fileName);
+
+    /**
+     * @brief Gets the number of atlas pages created so far.
+     */
+    size_t
+      getAtlasPageCount() const {
+      return m_atlasPages.size();
+    }
+
+    /**
+     * @brief Gets a loaded texture.
+     * @return The texture, or the in-memory placeholder if it was never loaded.
+     */
     EngineUtilities::TSharedPointer<Texture>
       getTexture(const std::string& fileName);
+
 private:
-    std::unordered_map<std::string, EngineUtilities::TSharedPointer<Texture>> m_textures;
-};
\ No newline at end of file
+    /**
+     * @brief Image decoded by a worker, waiting for its upload.
+     */
+    struct DecodedImage {
+      std::string fileName;
+      sf::Image image;
+      bool success = false;
+    };
+
+    /**
+     * @brief Gets the checkerboard image shown while a texture loads.
+     */
+    static const sf::Image&
+      getPlaceholderImage();
+
+    /**
+     * @brief Gets the memory a texture accounts for.
+     */
+    static size_t
+      textureBytes(const EngineUtilities::TSharedPointer<Texture>& texture);
+
+    /**
+     * @brief Publishes the resident texture memory and the images waiting for upload to the MemoryTracker.
+     */
+    void
+      reportMemoryUsage();
+
+    TResourceTable<Texture> m_textures;
+    size_t m_memoryBudget = DEFAULT_TEXTURE_BUDGET;
+    std::vector<EngineUtilities::TSharedPointer<Texture>> m_atlasPages;
+    std::unordered_map<std::string, TextureRegion> m_atlasRegions; /**< Packed textures by file name. */
+    std::mutex m_decodedMutex;
+    std::vector<DecodedImage> m_decoded; /**< Filled by the workers, drained by processUploads. */
+    JobCounter m_pendingDecodes{ 0 };
+};
@@ -0,0 +1,237 @@
+#pragma once
+#include "Prerequisites.h"
+#include <algorithm>
+
+/**
+ * @brief Generational reference to a resource stored in a TResourceTable.
+ *
+ * The index addresses a slot directly, so resolving a handle does no string
+ * hashing. The generation changes every time the slot is reused: a handle to
+ * an evicted resource stops resolving instead of pointing at the new one.
+ */
+template<typename T>
+struct THandle {
+  static constexpr uint32_t INVALID = 0xFFFFFFFFu;
+
+  uint32_t index = INVALID; /**< Slot of the resource in its table. */
+  uint32_t generation = 0;  /**< Generation of the slot when the handle was made. */
+
+  bool
+    isValid() const {
+    return index != INVALID;
+  }
+
+  bool
+    operator==(const THandle& other) const {
+    return index == other.index && generation == other.generation;
+  }
+
+  bool
+    operator!=(const THandle& other) const {
+    return !(*this == other);
+  }
+};
+
+/**
+ * @class TResourceTable
+ * @brief Slot array of named resources with generational handles and LRU eviction.
+ *
+ * Names are only hashed by find() and insert() (load time). Every get() marks the
+ * slot as used in the current frame; evict() drops the least recently used
+ * resources that nothing else references (use count 1, the table's own pointer)
+ * until the resident bytes fit the budget.
+ */
+template<typename T>
+class
+  TResourceTable {
+public:
+  using Handle = THandle<T>;
+
+  /**
+   * @brief Adds a resource, or replaces the one with the same name.
+   * @param name Key used by find().
+   * @param resource The resource.
+   * @param bytes Memory the resource accounts for.
+   * @return Handle to the resource.
+   */
+  Handle
+    insert(const std::string& name, const EngineUtilities::TSharedPointer<T>& resource, size_t bytes) {
+    auto it = m_lookup.find(name);
+    uint32_t index;
+    if (it != m_lookup.end()) {
+      index = it->second;
+      m_residentBytes -= m_slots[index].bytes;
+    }
+    else if (!m_freeSlots.empty()) {
+      index = m_freeSlots.back();
+      m_freeSlots.pop_back();
+    }
+    else {
+      index = static_cast<uint32_t>(m_slots.size());
+      m_slots.emplace_back();
+    }
+
+    Slot& slot = m_slots[index];
+    slot.resource = resource;
+    slot.name = name;
+    slot.bytes = bytes;
+    slot.lastUsedFrame = m_frame;
+    slot.occupied = true;
+    m_residentBytes += bytes;
+    m_lookup[name] = index;
+    return Handle{ index, slot.generation };
+  }
+
+  /**
+   * @brief Looks a resource up by name (hashes the string, keep it off hot paths).
+   * @return Its handle, or an invalid handle if it is not resident.
+   */
+  Handle
+    find(const std::string& name) const {
+    auto it = m_lookup.find(name);
+    if (it == m_lookup.end()) {
+      return Handle();
+    }
+    return Handle{ it->second, m_slots[it->second].generation };
+  }
+
+  /**
+   * @brief Resolves a handle and marks the resource as used this frame.
+   * @return The resource, or an empty pointer if the handle is stale.
+   */
+  EngineUtilities::TSharedPointer<T>
+    get(Handle handle) {
+    if (!isValid(handle)) {
+      return EngineUtilities::TSharedPointer<T>();
+    }
+    Slot& slot = m_slots[handle.index];
+    slot.lastUsedFrame = m_frame;
+    return slot.resource;
+  }
+
+  /**
+   * @brief Marks a resource as used this frame without resolving it.
+   */
+  void
+    touch(Handle handle) {
+    if (isValid(handle)) {
+      m_slots[handle.index].lastUsedFrame = m_frame;
+    }
+  }
+
+  /**
+   * @brief Checks if a handle still refers to a resident resource.
+   */
+  bool
+    isValid(Handle handle) const {
+    return handle.index < m_slots.size() &&
+           m_slots[handle.index].occupied &&
+           m_slots[handle.index].generation == handle.generation;
+  }
+
+  /**
+   * @brief Updates the memory a resource accounts for (e.g. after its upload).
+   */
+  void
+    setBytes(Handle handle, size_t bytes) {
+    if (!isValid(handle)) {
+      return;
+    }
+    Slot& slot = m_slots[handle.index];
+    m_residentBytes = m_residentBytes - slot.bytes + bytes;
+    slot.bytes = bytes;
+  }
+
+  /**
+   * @brief Starts a new frame for the LRU bookkeeping.
+   */
+  void
+    nextFrame() {
+    ++m_frame;
+  }
+
+  /**
+   * @brief Drops unreferenced resources, least recently used first, until the budget fits.
+   * Resources used this frame are kept.
+   * @param budget Maximum resident bytes.
+   * @return Number of resources evicted.
+   */
+  size_t
+    evict(size_t budget) {
+    if (m_residentBytes <= budget) {
+      return 0;
+    }
+
+    std::vector<uint32_t> candidates;
+    for (uint32_t index = 0; index < m_slots.size(); ++index) {
+      const Slot& slot = m_slots[index];
+      if (slot.occupied && slot.lastUsedFrame != m_frame && slot.resource.useCount() == 1) {
+        candidates.push_back(index);
+      }
+    }
+    std::sort(candidates.begin(), candidates.end(), [this](uint32_t a, uint32_t b) {
+      return m_slots[a].lastUsedFrame < m_slots[b].lastUsedFrame;
+    });
+
+    size_t evicted = 0;
+    for (uint32_t index : candidates) {
+      if (m_residentBytes <= budget) {
+        break;
+      }
+      remove(index);
+      ++evicted;
+    }
+    return evicted;
+  }
+
+  /**
+   * @brief Gets the bytes of every resident resource.
+   */
+  size_t
+    getResidentBytes() const {
+    return m_residentBytes;
+  }
+
+  /**
+   * @brief Gets the number of resident resources.
+   */
+  size_t
+    size() const {
+    return m_lookup.size();
+  }
+
+private:
+  /**
+   * @brief Storage of one resource.
+   */
+  struct Slot {
+    EngineUtilities::TSharedPointer<T> resource;
+    std::string name;
+    size_t bytes = 0;
+    uint64_t lastUsedFrame = 0;
+    uint32_t generation = 0;
+    bool occupied = false;
+  };
+
+  /**
+   * @brief Frees a slot and bumps its generation so old handles stop resolving.
+   */
+  void
+    remove(uint32_t index) {
+    Slot& slot = m_slots[index];
+    m_lookup.erase(slot.name);
+    m_residentBytes -= slot.bytes;
+    slot.resource.reset();
+    slot.name.clear();
+    slot.bytes = 0;
+    slot.occupied = false;
+    ++slot.generation;
+    m_freeSlots.push_back(index);
+  }
+
+  std::vector<Slot> m_slots;
+  std::vector<uint32_t> m_freeSlots;
+  std::unordered_map<std::string, uint32_t> m_lookup;
+  size_t m_residentBytes = 0;
+  uint64_t m_frame = 0;
+};
@@ -0,0 +1,108 @@
+#pragma once
+#include "Prerequisites.h"
+
+class Window;
+
+/**
+ * @brief Counters of the last SpriteBatch flush.
+ * Filled even without a window, so headless runs can check the batching.
+ */
+struct RenderStats {
+  size_t drawCalls = 0; /**< Draw calls submitted (one per non-empty batch). */
+  size_t vertices = 0;  /**< Vertices submitted across all batches. */
+  size_t sprites = 0;   /**< Shapes gathered into the batches. */
+};
+
+/**
+ * @class SpriteBatch
+ * @brief Gathers shapes into one triangle list per texture and blend mode.
+ *
+ * Shapes are transformed on the CPU and appended to the vertex array of their
+ * batch, so every texture costs a single draw call instead of one per shape.
+ * Batches are drawn by layer, and inside a layer in the order their first shape
+ * was submitted; shapes of the same layer must not rely on overlapping order
+ * between different textures. Outlines are batched too: they go, untextured,
+ * into the untextured batch of the shape's layer, so a textured shape with an
+ * outline costs one extra draw call per layer, not one per shape.
+ */
+class
+  SpriteBatch {
+public:
+  /**
+   * @brief Default constructor.
+   */
+  SpriteBatch() = default;
+
+  /**
+   * @brief Starts a new frame. Clears the batches but keeps their memory.
+   */
+  void
+    begin();
+
+  /**
+   * @brief Adds a shape to the batch of its texture.
+   * @param shape The shape to draw.
+   * @param layer Draw layer, lower layers are drawn first.
+   * @param blendMode Blend mode of the shape.
+   */
+  void
+    submit(const sf::Shape& shape, int layer = 0, const sf::BlendMode& blendMode = sf::BlendAlpha);
+
+  /**
+   * @brief Draws every non-empty batch and updates the stats.
+   * @param window Target window, or null to only count (headless).
+   */
+  void
+    flush(const EngineUtilities::TSharedPointer<Window>& window);
+
+  /**
+   * @brief Gets the counters of the last flush.
+   */
+  const RenderStats&
+    getStats() const {
+    return m_stats;
+  }
+
+  /**
+   * @brief Calls func(texture, vertices) for every batch of the last flush, in draw order.
+   * Lets headless runs check what would be drawn.
+   */
+  template<typename Func>
+  void
+    forEachBatch(Func&& func) const {
+    for (size_t index : m_drawOrder) {
+      func(m_batches[index].texture, m_batches[index].vertices);
+    }
+  }
+
+private:
+  /**
+   * @brief Vertices that share texture, blend mode and layer.
+   */
+  struct Batch {
+    int layer = 0;
+    const sf::Texture* texture = nullptr;
+    sf::BlendMode blendMode;
+    size_t order = 0; /**< Submission order of the first shape this frame. */
+    sf::VertexArray vertices{ sf::PrimitiveType::Triangles };
+  };
+
+  /**
+   * @brief Appends the outline band of a shape to the untextured batch of its layer.
+   * @param center Center of the local bounds, tells the outer side of every edge.
+   */
+  void
+    appendOutline(const sf::Shape& shape, int layer, const sf::BlendMode& blendMode, const sf::Vector2f& center);
+
+  /**
+   * @brief Finds the batch for a key, reusing or creating one.
+   */
+  Batch&
+    findBatch(int layer, const sf::Texture* texture, const sf::BlendMode& blendMode);
+
+  std::vector<Batch> m_batches;
+  std::vector<size_t> m_drawOrder;       /**< Batch indices sorted for drawing. */
+  std::vector<sf::Vertex> m_shapeVertices; /**< Scratch buffer for the points of one shape. */
+  size_t m_nextOrder = 0;
+  RenderStats m_stats;
+};
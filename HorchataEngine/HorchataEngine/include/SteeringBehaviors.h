@@ -1,12 +1,57 @@
 #pragma once
 
 #include "Prerequisites.h"
+#include "Path.h"
+#include "TrackCollisionMask.h"
+#include <functional>
 
 class Actor;
+class SteeringBehavior;
+class SpatialHashGrid;
+
+/**
+ * @brief Agent data the steering behaviors work on, one element per agent in every array.
+ * Filled by SteeringSystem for a whole group of agents, or for a single racer by ARacer::update.
+ */
+struct SteeringBatch {
+  const EngineMath::Vector2* positions = nullptr;
+  const EngineMath::Vector2* velocities = nullptr;
+  const float* maxSpeeds = nullptr;
+  const float* maxForces = nullptr;              /**< Force budget of each agent, see SteeringCombiner. */
+  const uint32_t* waypoints = nullptr;           /**< Current waypoint of each agent (see GameManager). */
+  EngineMath::Vector2* forces = nullptr;         /**< Output of SteeringCombiner::combine. */
+  EngineMath::Vector2* behaviorForces = nullptr; /**< Output of one behavior, working space of the combiner. */
+  EngineMath::Vector2* levelForces = nullptr;    /**< Working space of the combiner. */
+  float* budgets = nullptr;                      /**< Working space of the combiner. */
+  EngineMath::Vector2* scratchVectors = nullptr; /**< Working space of the behaviors. */
+  float* scratchFloats = nullptr;                /**< Working space of the behaviors. */
+  const SpatialHashGrid* neighbors = nullptr;    /**< Every agent of the arrays, entry ids are array indices. Null disables the neighbour behaviors.
+                                                       Entries past the steered agents only have a position and a velocity. */
+};
+
+/**
+ * @brief A behavior with the weight and priority it has on one agent.
+ */
+struct WeightedSteering {
+  const SteeringBehavior* behavior = nullptr;
+  float weight = 1.f;  /**< Scale of the force inside its priority level. */
+  int priority = 0;    /**< Higher levels take the force budget first. */
+
+  bool
+    operator<(const WeightedSteering& other) const {
+    if (priority != other.priority) return priority > other.priority;
+    if (behavior != other.behavior) return std::less<const SteeringBehavior*>()(behavior, other.behavior);
+    return weight < other.weight;
+  }
+};
 
 /**
  * @class SteeringBehavior
  * @brief Abstract base class for steering behaviors applied to actors.
+ *
+ * A behavior only computes a steering force (desired velocity minus current
+ * velocity) per agent; SteeringCombiner mixes the forces of every behavior of
+ * an agent and integrates once.
  */
 class SteeringBehavior
 {
@@ -18,40 +63,92 @@ public:
   virtual ~SteeringBehavior() = default;
 
   /**
-   * @brief Applies the steering behavior to the given actor.
-   * @param actor Pointer to the actor to apply the behavior to.
-   * @param deltaTime Time elapsed since the last update.
+   * @brief Computes the steering force of the agents [begin, end) of a batch.
+   * Behaviors keep no per-agent state, so one instance can be shared by many agents
+   * and different ranges can run on different threads.
+   * @param batch Arrays of the agents.
+   * @param begin First agent.
+   * @param end One past the last agent.
+   * @param forces Output, indexed like the batch arrays.
+   */
+  virtual void computeForces(const SteeringBatch& batch, size_t begin, size_t end, EngineMath::Vector2* forces) const = 0;
+
+  /**
+   * @brief Gets how far the behavior looks for other agents in batch.neighbors.
+   * @return 0 if the behavior does not use neighbours.
+   */
+  virtual float getNeighborRadius() const {
+    return 0.f;
+  }
+};
+
+/**
+ * @class SteeringCombiner
+ * @brief Mixes the forces of stacked behaviors and moves the agents once.
+ *
+ * Behaviors are grouped by priority, highest first. Inside a level the forces
+ * are added by weight; each level then gets what is left of the agent's force
+ * budget (maxForces), the last one that fits is cut short ("prioritized
+ * truncation"). So avoidance at a high priority can take the whole budget
+ * when it needs it and leave it to path following otherwise.
+ */
+class
+  SteeringCombiner {
+public:
+  /**
+   * @brief Computes the combined force of the agents [begin, end) into batch.forces.
+   * @param behaviors Behaviors of the agents, sorted (see WeightedSteering::operator<).
+   */
+  static void
+    combine(const std::vector<WeightedSteering>& behaviors, const SteeringBatch& batch, size_t begin, size_t end);
+
+  /**
+   * @brief Applies the forces: one velocity update, clamped to the max speed, and one position update.
    */
-  virtual void apply(Actor* actor, float deltaTime) = 0;
+  static void
+    integrate(EngineMath::Vector2* positions,
+              EngineMath::Vector2* velocities,
+              const EngineMath::Vector2* forces,
+              const float* maxSpeeds,
+              size_t count,
+              float deltaTime);
 };
 
 /**
  * @class PathFollowing
- * @brief Steering behavior for following a series of waypoints.
+ * @brief Steering behavior for following the waypoints of a shared Path.
  */
 class PathFollowing : public SteeringBehavior
 {
 public:
 
   /**
-   * @brief Constructs a PathFollowing behavior with a list of waypoints.
-   * @param waypoints Vector of waypoints to follow.
+   * @brief Constructs a PathFollowing behavior on a path.
+   * @param path Path to follow, shared with every other racer on it.
    */
-  PathFollowing(const std::vector<EngineMath::Vector2>& waypoints);
+  PathFollowing(const EngineUtilities::TSharedPointer<Path>& path);
 
   /**
-   * @brief Applies the path following behavior to the given actor.
-   * @param actor Pointer to the actor to apply the behavior to.
-   * @param deltaTime Time elapsed since the last update.
+   * @brief Seeks the current waypoint of every agent, slowing down close to it.
    */
-  void apply(Actor* actor, float deltaTime) override;
+  void computeForces(const SteeringBatch& batch, size_t begin, size_t end, EngineMath::Vector2* forces) const override;
 
 private:
 
   /**
-   * @brief List of waypoints for the path following behavior.
+   * @brief Path to follow, its points are the waypoints.
+   */
+  EngineUtilities::TSharedPointer<Path> m_path;
+
+  /**
+   * @brief Distance to the current waypoint at which the racer aims at the next one.
+   */
+  float m_arrivalRadius = 50.f;
+
+  /**
+   * @brief Distance to the target below which the racer slows down.
    */
-  std::vector<EngineMath::Vector2> m_waypoints;
+  float m_slowingRadius = 200.f;
 };
 
 /**
@@ -69,11 +166,9 @@ public:
   Arrive(const EngineMath::Vector2& target);
 
   /**
-   * @brief Applies the arrive behavior to the given actor.
-   * @param actor Pointer to the actor to apply the behavior to.
-   * @param deltaTime Time elapsed since the last update.
+   * @brief Steers every agent to the target, slowing down inside the slowing radius.
    */
-  void apply(Actor* actor, float deltaTime) override;
+  void computeForces(const SteeringBatch& batch, size_t begin, size_t end, EngineMath::Vector2* forces) const override;
 
 private:
 
@@ -86,4 +181,149 @@ private:
    * @brief The radius within which the actor starts to slow down.
    */
   float m_slowingRadius = 150.f;
-};
\ No newline at end of file
+};
+
+/**
+ * @class Separation
+ * @brief Steers away from the agents closer than a radius, harder the closer they are.
+ */
+class Separation : public SteeringBehavior
+{
+public:
+
+  /**
+   * @brief Constructs a Separation behavior.
+   * @param radius Distance below which another agent pushes this one away.
+   */
+  explicit Separation(float radius = 40.f);
+
+  /**
+   * @brief Pushes every agent away from its neighbours, up to its max force per neighbour.
+   */
+  void computeForces(const SteeringBatch& batch, size_t begin, size_t end, EngineMath::Vector2* forces) const override;
+
+  float getNeighborRadius() const override {
+    return m_radius;
+  }
+
+private:
+
+  /**
+   * @brief Distance below which another agent pushes this one away.
+   */
+  float m_radius;
+};
+
+/**
+ * @class Alignment
+ * @brief Steers towards the average velocity of the neighbours.
+ */
+class Alignment : public SteeringBehavior
+{
+public:
+
+  /**
+   * @brief Constructs an Alignment behavior.
+   * @param radius Distance at which other agents count as neighbours.
+   */
+  explicit Alignment(float radius = 80.f);
+
+  /**
+   * @brief Matches the velocity of every agent to the mean velocity of its neighbours.
+   */
+  void computeForces(const SteeringBatch& batch, size_t begin, size_t end, EngineMath::Vector2* forces) const override;
+
+  float getNeighborRadius() const override {
+    return m_radius;
+  }
+
+private:
+
+  /**
+   * @brief Distance at which other agents count as neighbours.
+   */
+  float m_radius;
+};
+
+/**
+ * @class Cohesion
+ * @brief Steers towards the center of the neighbours.
+ */
+class Cohesion : public SteeringBehavior
+{
+public:
+
+  /**
+   * @brief Constructs a Cohesion behavior.
+   * @param radius Distance at which other agents count as neighbours.
+   */
+  explicit Cohesion(float radius = 80.f);
+
+  /**
+   * @brief Seeks the mean position of the neighbours of every agent at full speed.
+   */
+  void computeForces(const SteeringBatch& batch, size_t begin, size_t end, EngineMath::Vector2* forces) const override;
+
+  float getNeighborRadius() const override {
+    return m_radius;
+  }
+
+private:
+
+  /**
+   * @brief Distance at which other agents count as neighbours.
+   */
+  float m_radius;
+};
+
+/**
+ * @class WallAvoidance
+ * @brief Steers away from the death zones of the track before the agent reaches them.
+ *
+ * Samples the signed distance field of the track mask a little ahead of the
+ * agent; when the edge is closer than the avoid distance, pushes along the
+ * gradient of the field (towards the road), harder the closer the edge.
+ * Needs a mask built with its distance field; without one, or when the
+ * look-ahead point falls outside the track rectangle, it gives no force.
+ */
+class WallAvoidance : public SteeringBehavior
+{
+public:
+
+  /**
+   * @brief Constructs a WallAvoidance behavior on a track mask.
+   * @param mask Track mask with a distance field, shared with the GameManager.
+   * @param lookAhead Seconds of the current velocity the agent looks ahead.
+   * @param avoidDistance Distance to the edge at which the agent starts to turn away.
+   */
+  WallAvoidance(const EngineUtilities::TSharedPointer<TrackCollisionMask>& mask,
+                float lookAhead = 0.25f,
+                float avoidDistance = 40.f);
+
+  /**
+   * @brief Pushes every agent whose look-ahead point is near an edge back to the road.
+   */
+  void computeForces(const SteeringBatch& batch, size_t begin, size_t end, EngineMath::Vector2* forces) const override;
+
+private:
+
+  /**
+   * @brief Death zones of the track and their distance field.
+   */
+  EngineUtilities::TSharedPointer<TrackCollisionMask> m_mask;
+
+  /**
+   * @brief Seconds of the current velocity the agent looks ahead.
+   */
+  float m_lookAhead;
+
+  /**
+   * @brief Distance to the edge at which the agent starts to turn away.
+   */
+  float m_avoidDistance;
+
+  /**
+   * @brief Step of the central differences that estimate the gradient of the field.
+   */
+  float m_sampleStep = 8.f;
+};
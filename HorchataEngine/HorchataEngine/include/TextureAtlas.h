@@ -0,0 +1,107 @@
+#pragma once
+#include "Prerequisites.h"
+
+/**
+ * @class TextureAtlas
+ * @brief Packs many small images into a few large pages (shelf packer).
+ *
+ * Images are added by name, then pack() sorts them by height and places them
+ * on shelves, left to right, opening a new page when one is full. The pages
+ * and the region table can be written to disk and read back, so a startup
+ * with unchanged sources does not decode and repack every sprite.
+ * Only CPU images are handled here; ResourceManager uploads the pages.
+ */
+class
+  TextureAtlas {
+public:
+  /**
+   * @brief Place of an image inside the atlas.
+   */
+  struct Region {
+    size_t page = 0;   /**< Index of the page that holds the image. */
+    sf::IntRect rect;  /**< Pixel rectangle of the image inside the page. */
+  };
+
+  /**
+   * @brief Creates an empty atlas.
+   * @param pageSize Width and height of every page in pixels.
+   * @param padding Empty pixels kept around every image, avoids filtering bleed.
+   */
+  explicit TextureAtlas(unsigned int pageSize = 2048, unsigned int padding = 2);
+
+  /**
+   * @brief Queues an image for the next pack().
+   * @return False if the image is too big to share a page (over half the page size).
+   */
+  bool
+    add(const std::string& name, const sf::Image& image);
+
+  /**
+   * @brief Places every queued image and builds the pages.
+   * @return False if an image could not be copied into its page (logged, its region stays empty).
+   */
+  bool
+    pack();
+
+  /**
+   * @brief Looks up the region of a packed image.
+   * @return Null if the image is not in the atlas.
+   */
+  const Region*
+    findRegion(const std::string& name) const;
+
+  size_t
+    getPageCount() const {
+    return m_pages.size();
+  }
+
+  const sf::Image&
+    getPage(size_t index) const {
+    return m_pages[index];
+  }
+
+  const std::unordered_map<std::string, Region>&
+    getRegions() const {
+    return m_regions;
+  }
+
+  /**
+   * @brief Writes the pages as PNG files next to a text manifest with the regions.
+   * Names and paths are quoted in the manifest, so they may contain spaces. The folder
+   * is created if needed. A failed write is logged and leaves no manifest behind.
+   * @param manifestFile Path of the manifest; pages use it plus "_<page>.png".
+   * @param signature Value identifying the sources, see computeSignature.
+   * @return True if every file was written.
+   */
+  bool
+    saveToFile(const std::string& manifestFile, uint64_t signature) const;
+
+  /**
+   * @brief Reads an atlas written by saveToFile.
+   * @return False if the files are missing, invalid or were built from other sources.
+   */
+  bool
+    loadFromFile(const std::string& manifestFile, uint64_t signature);
+
+  /**
+   * @brief Hashes the path, size and modification time of every source file.
+   * Any changed, added or removed source gives a different value.
+   */
+  static uint64_t
+    computeSignature(const std::vector<std::string>& files);
+
+private:
+  /**
+   * @brief An image waiting for pack().
+   */
+  struct PendingImage {
+    std::string name;
+    sf::Image image;
+  };
+
+  unsigned int m_pageSize;
+  unsigned int m_padding;
+  std::vector<PendingImage> m_pending;
+  std::vector<sf::Image> m_pages;
+  std::unordered_map<std::string, Region> m_regions;
+};
@@ -0,0 +1,151 @@
+#pragma once
+#include "../Prerequisites.h"
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * @brief Counter of unfinished jobs that a caller can wait on.
+ */
+using JobCounter = std::atomic<size_t>;
+
+/**
+ * @class ThreadPool
+ * @brief Work-stealing pool of worker threads.
+ *
+ * Every worker owns a queue: it pops its own jobs from the back and steals from
+ * the front of the other queues when it runs dry. Threads that are not workers
+ * (the main thread) push to a shared queue and help running jobs while they wait,
+ * so waiting inside a job never deadlocks.
+ */
+class
+	ThreadPool {
+public:
+	/**
+	 * @brief Creates a pool with the given number of workers.
+	 * @param workerCount Number of worker threads (0 runs every job on the caller).
+	 */
+	explicit ThreadPool(unsigned int workerCount);
+
+	/**
+	 * @brief Finishes the queued jobs and joins the workers.
+	 */
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/**
+	 * @brief Gets the engine pool, one worker per hardware thread minus the main one.
+	 */
+	static ThreadPool&
+		getInstance();
+
+	/**
+	 * @brief Queues a job.
+	 * @param job Function to run.
+	 * @param counter Optional counter decremented when the job finishes.
+	 */
+	void
+		submit(std::function<void()> job, JobCounter* counter = nullptr);
+
+	/**
+	 * @brief Runs queued jobs on the calling thread until counter reaches zero.
+	 */
+	void
+		wait(const JobCounter& counter);
+
+	/**
+	 * @brief Splits [0, count) into ranges of grainSize and runs func(begin, end)
+	 * on each of them across the pool. Returns when every range is done.
+	 * @param count Number of elements.
+	 * @param grainSize Elements per job, 0 picks a size from the worker count.
+	 * @param func Callable with signature void(size_t begin, size_t end).
+	 */
+	template<typename Func>
+	void
+		parallelFor(size_t count, size_t grainSize, Func&& func) {
+		if (count == 0) {
+			return;
+		}
+		if (grainSize == 0) {
+			// Four ranges per thread keeps the pool busy when ranges are uneven
+			grainSize = count / ((m_workers.size() + 1) * 4);
+			grainSize = grainSize > 0 ? grainSize : 1;
+		}
+		if (m_workers.empty() || count <= grainSize) {
+			func(static_cast<size_t>(0), count);
+			return;
+		}
+
+		JobCounter remaining{ 0 };
+		for (size_t begin = grainSize; begin < count; begin += grainSize) {
+			const size_t end = begin + grainSize < count ? begin + grainSize : count;
+			remaining.fetch_add(1, std::memory_order_relaxed);
+			submit([&func, begin, end]() { func(begin, end); }, &remaining);
+		}
+
+		// The caller takes the first range, then helps with the rest
+		func(static_cast<size_t>(0), grainSize);
+		wait(remaining);
+	}
+
+	/**
+	 * @brief Gets the number of worker threads.
+	 */
+	size_t
+		getWorkerCount() const {
+		return m_workers.size();
+	}
+
+private:
+	/**
+	 * @brief A queued job and the counter it reports to.
+	 */
+	struct Job {
+		std::function<void()> function;
+		JobCounter* counter = nullptr;
+	};
+
+	/**
+	 * @brief Job queue owned by one thread.
+	 */
+	struct WorkQueue {
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	/**
+	 * @brief Main loop of a worker thread.
+	 * @param queueIndex Index of the queue owned by the worker.
+	 */
+	void
+		workerLoop(size_t queueIndex);
+
+	/**
+	 * @brief Takes a job from the own queue, or steals one from another queue.
+	 * @return True if a job was found.
+	 */
+	bool
+		findJob(size_t queueIndex, Job& job);
+
+	/**
+	 * @brief Runs a job and signals its counter.
+	 */
+	void
+		execute(Job& job);
+
+	/**
+	 * @brief Gets the queue of the calling thread (0 for non-worker threads).
+	 */
+	size_t
+		currentQueueIndex() const;
+
+	std::vector<std::thread> m_workers;
+	std::vector<EngineUtilities::TUniquePtr<WorkQueue>> m_queues; /**< Queue 0 is shared by non-worker threads. */
+	std::mutex m_sleepMutex;
+	std::condition_variable m_wakeUp;
+	std::atomic<size_t> m_pendingJobs{ 0 };
+	std::atomic<bool> m_running{ true };
+};
@@ -0,0 +1,155 @@
+#pragma once
+#include "Prerequisites.h"
+
+/**
+ * @class TrackCollisionMask
+ * @brief Packed 1-bit map of the death zones of a track, built once at load time.
+ *
+ * One bit per pixel of the track image, 64 pixels per word, so a lookup is an
+ * index computation and a bit test. The image is read from disk on the CPU
+ * (no GPU readback), which also lets the mask be built without a window.
+ * An optional signed distance field gives the distance to the nearest edge,
+ * positive on the road and negative inside death zones.
+ */
+class
+  TrackCollisionMask {
+public:
+  /**
+   * @brief Default constructor. The mask is empty until built.
+   */
+  TrackCollisionMask() = default;
+
+  /**
+   * @brief Loads an image file and builds the mask from it.
+   * The result is kept in the AssetCache, so later runs map it instead of decoding the image.
+   * @param fileName Path of the image.
+   * @param deathColor Pixels of this color are death zones.
+   * @param withDistanceField Also build (or load) the signed distance field.
+   * @return True if the image could be loaded. On failure the error is logged and the mask is left unchanged.
+   */
+  bool
+    loadFromFile(const std::string& fileName,
+                 const sf::Color& deathColor = sf::Color::Black,
+                 bool withDistanceField = false);
+
+  /**
+   * @brief Builds the mask from an image already in memory.
+   */
+  void
+    build(const sf::Image& image, const sf::Color& deathColor = sf::Color::Black);
+
+  /**
+   * @brief Builds the mask from raw RGBA8 pixels.
+   * @param width Width in pixels.
+   * @param height Height in pixels.
+   * @param pixels width * height * 4 bytes, row by row.
+   * @param deathColor Pixels of this color (alpha included) are death zones.
+   */
+  void
+    build(unsigned int width, unsigned int height, const uint8_t* pixels, const sf::Color& deathColor);
+
+  /**
+   * @brief Computes the signed distance field of the mask (two-pass chamfer).
+   * Distances are approximate, up to about 8% long on diagonals. Call after build;
+   * signedDistance returns 0 until then.
+   */
+  void
+    buildDistanceField();
+
+  /**
+   * @brief Sets the world rectangle the track image is stretched over.
+   * @param position Top-left corner in world units.
+   * @param size Size in world units.
+   */
+  void
+    setWorldBounds(const EngineMath::Vector2& position, const EngineMath::Vector2& size);
+
+  /**
+   * @brief Checks a pixel of the mask. Pixels outside the image are not death zones.
+   */
+  bool
+    isDeathPixel(unsigned int x, unsigned int y) const {
+    if (x >= m_width || y >= m_height) {
+      return false;
+    }
+    return (m_bits[y * m_wordsPerRow + (x >> 6)] >> (x & 63)) & 1u;
+  }
+
+  /**
+   * @brief Checks if a world position falls on a death zone of the track.
+   * Positions outside the track rectangle are not death zones.
+   */
+  bool
+    isDeath(const EngineMath::Vector2& worldPosition) const;
+
+  /**
+   * @brief Gets the distance from a world position to the nearest track edge, in world units.
+   * @return Positive on the road, negative inside death zones, 0 without a distance field
+   * or outside the track rectangle (see hasDistanceField and contains).
+   */
+  float
+    signedDistance(const EngineMath::Vector2& worldPosition) const;
+
+  /**
+   * @brief Checks if a world position falls inside the track rectangle.
+   */
+  bool
+    contains(const EngineMath::Vector2& worldPosition) const;
+
+  /**
+   * @brief Checks if the signed distance field has been built.
+   */
+  bool
+    hasDistanceField() const {
+    return !m_distanceField.empty();
+  }
+
+  /**
+   * @brief Checks if the mask has been built.
+   */
+  bool
+    isEmpty() const {
+    return m_bits.empty();
+  }
+
+  unsigned int
+    getWidth() const {
+    return m_width;
+  }
+
+  unsigned int
+    getHeight() const {
+    return m_height;
+  }
+
+private:
+  /**
+   * @brief Writes the mask (and distance field) into a flat blob for the AssetCache.
+   */
+  std::vector<uint8_t>
+    serialize() const;
+
+  /**
+   * @brief Reads a blob written by serialize.
+   * @return False if the blob is malformed.
+   */
+  bool
+    deserialize(const uint8_t* data, size_t size);
+
+  /**
+   * @brief Converts a world position to pixel coordinates.
+   * @return False if the position lies outside the track rectangle.
+   */
+  bool
+    worldToPixel(const EngineMath::Vector2& worldPosition, unsigned int& x, unsigned int& y) const;
+
+  unsigned int m_width = 0;
+  unsigned int m_height = 0;
+  size_t m_wordsPerRow = 0;
+  std::vector<uint64_t> m_bits; /**< Death bits, m_wordsPerRow words per row. */
+  std::vector<float> m_distanceField; /**< Signed distance in pixels, empty until built. */
+
+  EngineMath::Vector2 m_worldPosition; /**< Top-left corner of the track in world units. */
+  EngineMath::Vector2 m_pixelsPerUnit; /**< Image pixels per world unit on each axis. */
+  float m_unitsPerPixel = 1.0f; /**< Average world units per pixel, scales the distance field. */
+};
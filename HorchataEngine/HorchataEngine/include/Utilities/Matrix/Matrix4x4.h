@@ -191,14 +191,29 @@ namespace EngineMath {
     Matrix4x4 
       operator*(const Matrix4x4& other) const {
       Matrix4x4 result;
+#if defined(ENGINEMATH_SSE)
+      // Each result row is a combination of the rows of other weighted by this row
+      const __m128 row0 = _mm_loadu_ps(other.m);
+      const __m128 row1 = _mm_loadu_ps(other.m + 4);
+      const __m128 row2 = _mm_loadu_ps(other.m + 8);
+      const __m128 row3 = _mm_loadu_ps(other.m + 12);
+      for (int i = 0; i < 4; ++i) {
+        __m128 r = _mm_mul_ps(_mm_set1_ps(m[i * 4 + 0]), row0);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m[i * 4 + 1]), row1));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m[i * 4 + 2]), row2));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m[i * 4 + 3]), row3));
+        _mm_storeu_ps(result.m + i * 4, r);
+      }
+#else
       for (int i = 0; i < 4; ++i) {
         for (int j = 0; j < 4; ++j) {
-          result.m[i * 4 + j] = 0.0f;
-          for (int k = 0; k < 4; ++k) {
-            result.m[i * 4 + j] += m[i * 4 + k] * other.m[k * 4 + j];
-          }
+          result.m[i * 4 + j] = m[i * 4 + 0] * other.m[j] +
+            m[i * 4 + 1] * other.m[4 + j] +
+            m[i * 4 + 2] * other.m[8 + j] +
+            m[i * 4 + 3] * other.m[12 + j];
         }
       }
+#endif
       return result;
     }
     
@@ -210,12 +225,25 @@ namespace EngineMath {
 		*/
     Vector4 
       operator*(const Vector4& vec) const {
+#if defined(ENGINEMATH_SSE)
+      const __m128 v = _mm_setr_ps(vec.x, vec.y, vec.z, vec.w);
+      __m128 r0 = _mm_mul_ps(_mm_loadu_ps(m), v);
+      __m128 r1 = _mm_mul_ps(_mm_loadu_ps(m + 4), v);
+      __m128 r2 = _mm_mul_ps(_mm_loadu_ps(m + 8), v);
+      __m128 r3 = _mm_mul_ps(_mm_loadu_ps(m + 12), v);
+      // After the transpose, adding the four registers gives the four dot products
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+      alignas(16) float out[4];
+      _mm_store_ps(out, _mm_add_ps(_mm_add_ps(r0, r1), _mm_add_ps(r2, r3)));
+      return Vector4(out[0], out[1], out[2], out[3]);
+#else
       return Vector4(
         m[0] * vec.x + m[1] * vec.y + m[2] * vec.z + m[3] * vec.w,
         m[4] * vec.x + m[5] * vec.y + m[6] * vec.z + m[7] * vec.w,
         m[8] * vec.x + m[9] * vec.y + m[10] * vec.z + m[11] * vec.w,
         m[12] * vec.x + m[13] * vec.y + m[14] * vec.z + m[15] * vec.w
       );
+#endif
     }
     
     /*
@@ -320,66 +348,112 @@ namespace EngineMath {
       @return A new Matrix4x4 instance that is the inverse of this matrix.
       @details This method calculates the inverse of the matrix, which is useful for undoing transformations.
 			If the matrix is not invertible, it returns a zero matrix.
+      The SSE path splits the matrix in four 2x2 blocks and inverts it through their
+      adjugates; the scalar path expands the cofactors.
 		*/
     Matrix4x4 
       inverse() const {
-      float det = determinant();
+      const Matrix4x4 zero(0.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 0.0f);
+#if defined(ENGINEMATH_SSE)
+      const __m128 row0 = _mm_loadu_ps(m);
+      const __m128 row1 = _mm_loadu_ps(m + 4);
+      const __m128 row2 = _mm_loadu_ps(m + 8);
+      const __m128 row3 = _mm_loadu_ps(m + 12);
+
+      // 2x2 blocks stored as (a00, a01, a10, a11)
+      const __m128 A = _mm_movelh_ps(row0, row1);
+      const __m128 B = _mm_movehl_ps(row1, row0);
+      const __m128 C = _mm_movelh_ps(row2, row3);
+      const __m128 D = _mm_movehl_ps(row3, row2);
+
+      // (|A|, |B|, |C|, |D|)
+      const __m128 detSub = _mm_sub_ps(
+        _mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(3, 1, 3, 1))),
+        _mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(2, 0, 2, 0))));
+      const __m128 detA = swizzle<0, 0, 0, 0>(detSub);
+      const __m128 detB = swizzle<1, 1, 1, 1>(detSub);
+      const __m128 detC = swizzle<2, 2, 2, 2>(detSub);
+      const __m128 detD = swizzle<3, 3, 3, 3>(detSub);
+
+      const __m128 D_C = mat2AdjMul(D, C);
+      const __m128 A_B = mat2AdjMul(A, B);
+      __m128 X_ = _mm_sub_ps(_mm_mul_ps(detD, A), mat2Mul(B, D_C));
+      __m128 W_ = _mm_sub_ps(_mm_mul_ps(detA, D), mat2Mul(C, A_B));
+      __m128 Y_ = _mm_sub_ps(_mm_mul_ps(detB, C), mat2MulAdj(D, A_B));
+      __m128 Z_ = _mm_sub_ps(_mm_mul_ps(detC, B), mat2MulAdj(A, D_C));
+
+      // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+      __m128 trace = _mm_mul_ps(A_B, swizzle<0, 2, 1, 3>(D_C));
+      trace = _mm_add_ps(trace, swizzle<2, 3, 0, 1>(trace));
+      trace = _mm_add_ps(trace, swizzle<1, 0, 3, 2>(trace));
+      const __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+
+      const float det = _mm_cvtss_f32(detM);
       if (EngineMath::approxEqual(det, 0.0f)) {
         // Matriz no invertible.
-        return Matrix4x4(0.0f, 0.0f, 0.0f, 0.0f,
-          0.0f, 0.0f, 0.0f, 0.0f,
-          0.0f, 0.0f, 0.0f, 0.0f,
-          0.0f, 0.0f, 0.0f, 0.0f);
+        return zero;
       }
-      
-      float invDet = 1.0f / det;
-      Matrix4x4 result;
 
-      result.m[0] = (m[5] * (m[10] * m[15] - m[11] * m[14]) -
-        m[6] * (m[9] * m[15] - m[11] * m[13]) +
-        m[7] * (m[9] * m[14] - m[10] * m[13])) * invDet;
+      const __m128 rDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+      X_ = _mm_mul_ps(X_, rDetM);
+      Y_ = _mm_mul_ps(Y_, rDetM);
+      Z_ = _mm_mul_ps(Z_, rDetM);
+      W_ = _mm_mul_ps(W_, rDetM);
 
-      result.m[4] = (m[6] * (m[11] * m[12] - m[8] * m[15]) -
-        m[4] * (m[10] * m[15] - m[11] * m[14]) -
-        m[7] * (m[9] * m[12] - m[8] * m[13])) * invDet;
+      // Adjugate of each block and back to rows in one shuffle
+      Matrix4x4 result;
+      _mm_storeu_ps(result.m, _mm_shuffle_ps(X_, Y_, _MM_SHUFFLE(1, 3, 1, 3)));
+      _mm_storeu_ps(result.m + 4, _mm_shuffle_ps(X_, Y_, _MM_SHUFFLE(0, 2, 0, 2)));
+      _mm_storeu_ps(result.m + 8, _mm_shuffle_ps(Z_, W_, _MM_SHUFFLE(1, 3, 1, 3)));
+      _mm_storeu_ps(result.m + 12, _mm_shuffle_ps(Z_, W_, _MM_SHUFFLE(0, 2, 0, 2)));
+      return result;
+#else
+      // 2x2 sub-determinants of the two top rows and the two bottom rows
+      const float s0 = m[0] * m[5] - m[4] * m[1];
+      const float s1 = m[0] * m[6] - m[4] * m[2];
+      const float s2 = m[0] * m[7] - m[4] * m[3];
+      const float s3 = m[1] * m[6] - m[5] * m[2];
+      const float s4 = m[1] * m[7] - m[5] * m[3];
+      const float s5 = m[2] * m[7] - m[6] * m[3];
+
+      const float c5 = m[10] * m[15] - m[14] * m[11];
+      const float c4 = m[9] * m[15] - m[13] * m[11];
+      const float c3 = m[9] * m[14] - m[13] * m[10];
+      const float c2 = m[8] * m[15] - m[12] * m[11];
+      const float c1 = m[8] * m[14] - m[12] * m[10];
+      const float c0 = m[8] * m[13] - m[12] * m[9];
 
-      result.m[0] = (m[5] * m[10] * m[15] + m[6] * m[11] * m[13] + m[7] * m[9] * m[14] -
-        m[7] * m[10] * m[13] - m[6] * m[9] * m[15] - m[5] * m[11] * m[14]) * invDet;
-      result.m[4] = (m[1] * m[11] * m[14] + m[2] * m[15] * m[13] + m[3] * m[9] * m[14] -
-        m[3] * m[10] * m[13] - m[2] * m[9] * m[15] - m[1] * m[11] * m[14]) * invDet;
-      result.m[8] = (m[1] * m[6] * m[15] + m[2] * m[7] * m[13] + m[3] * m[5] * m[14] -
-        m[3] * m[6] * m[13] - m[2] * m[5] * m[15] - m[1] * m[7] * m[14]) * invDet;
-      result.m[12] = (m[1] * m[7] * m[10] + m[2] * m[4] * m[11] + m[3] * m[5] * m[9] -
-        m[3] * m[6] * m[9] - m[2] * m[5] * m[11] - m[1] * m[4] * m[10]) * invDet;
+      const float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+      if (EngineMath::approxEqual(det, 0.0f)) {
+        // Matriz no invertible.
+        return zero;
+      }
 
-      result.m[1] = (m[3] * m[10] * m[13] + m[2] * m[9] * m[15] + m[1] * m[11] * m[14] -
-        m[1] * m[10] * m[15] - m[2] * m[11] * m[13] - m[3] * m[9] * m[14]) * invDet;
-      result.m[5] = (m[0] * m[10] * m[15] + m[2] * m[11] * m[12] + m[3] * m[8] * m[14] -
-        m[3] * m[10] * m[12] - m[2] * m[8] * m[15] - m[0] * m[11] * m[14]) * invDet;
-      result.m[9] = (m[0] * m[6] * m[15] + m[2] * m[7] * m[12] + m[3] * m[4] * m[14] -
-        m[3] * m[6] * m[12] - m[2] * m[4] * m[15] - m[0] * m[7] * m[14]) * invDet;
-      result.m[13] = (m[0] * m[7] * m[10] + m[2] * m[4] * m[11] + m[3] * m[5] * m[8] -
-        m[3] * m[6] * m[8] - m[2] * m[5] * m[11] - m[0] * m[4] * m[10]) * invDet;
+      const float invDet = 1.0f / det;
+      return Matrix4x4(
+        (m[5] * c5 - m[6] * c4 + m[7] * c3) * invDet,
+        (-m[1] * c5 + m[2] * c4 - m[3] * c3) * invDet,
+        (m[13] * s5 - m[14] * s4 + m[15] * s3) * invDet,
+        (-m[9] * s5 + m[10] * s4 - m[11] * s3) * invDet,
 
-      result.m[2] = (m[3] * m[6] * m[13] + m[2] * m[4] * m[15] + m[1] * m[7] * m[14] -
-        m[1] * m[6] * m[15] - m[2] * m[7] * m[13] - m[3] * m[4] * m[14]) * invDet;
-      result.m[6] = (m[0] * m[6] * m[15] + m[2] * m[7] * m[12] + m[3] * m[4] * m[14] -
-        m[3] * m[6] * m[12] - m[2] * m[4] * m[15] - m[0] * m[7] * m[14]) * invDet;
-      result.m[10] = (m[0] * m[5] * m[15] + m[1] * m[7] * m[12] + m[3] * m[4] * m[13] -
-        m[3] * m[5] * m[12] - m[1] * m[4] * m[15] - m[0] * m[7] * m[13]) * invDet;
-      result.m[14] = (m[0] * m[7] * m[9] + m[1] * m[4] * m[11] + m[3] * m[5] * m[8] -
-        m[3] * m[6] * m[8] - m[1] * m[5] * m[11] - m[0] * m[4] * m[10]) * invDet;
+        (-m[4] * c5 + m[6] * c2 - m[7] * c1) * invDet,
+        (m[0] * c5 - m[2] * c2 + m[3] * c1) * invDet,
+        (-m[12] * s5 + m[14] * s2 - m[15] * s1) * invDet,
+        (m[8] * s5 - m[10] * s2 + m[11] * s1) * invDet,
 
-      result.m[3] = (m[3] * m[6] * m[13] + m[2] * m[4] * m[15] + m[1] * m[7] * m[14] -
-        m[1] * m[6] * m[15] - m[2] * m[7] * m[13] - m[3] * m[4] * m[14]) * invDet;
-      result.m[7] = (m[0] * m[6] * m[15] + m[2] * m[7] * m[12] + m[3] * m[4] * m[14] -
-        m[3] * m[6] * m[12] - m[2] * m[4] * m[15] - m[0] * m[7] * m[14]) * invDet;
-      result.m[11] = (m[0] * m[5] * m[15] + m[1] * m[7] * m[12] + m[3] * m[4] * m[13] -
-        m[3] * m[5] * m[12] - m[1] * m[4] * m[15] - m[0] * m[7] * m[13]) * invDet;
-      result.m[15] = (m[0] * m[5] * m[10] + m[1] * m[6] * m[8] + m[2] * m[4] * m[9] -
-        m[2] * m[5] * m[8] - m[1] * m[4] * m[10] - m[0] * m[6] * m[9]) * invDet;
+        (m[4] * c4 - m[5] * c2 + m[7] * c0) * invDet,
+        (-m[0] * c4 + m[1] * c2 - m[3] * c0) * invDet,
+        (m[12] * s4 - m[13] * s2 + m[15] * s0) * invDet,
+        (-m[8] * s4 + m[9] * s2 - m[11] * s0) * invDet,
 
-      return result;
+        (-m[4] * c3 + m[5] * c1 - m[6] * c0) * invDet,
+        (m[0] * c3 - m[1] * c1 + m[2] * c0) * invDet,
+        (-m[12] * s3 + m[13] * s1 - m[14] * s0) * invDet,
+        (m[8] * s3 - m[9] * s1 + m[10] * s0) * invDet);
+#endif
     }
     
     /*
@@ -390,6 +464,13 @@ namespace EngineMath {
 		*/
     Vector3 
       transformPoint(const Vector3& point) const {
+      // Affine matrices (the common case) need no perspective divide
+      if (m[12] == 0.0f && m[13] == 0.0f && m[14] == 0.0f && m[15] == 1.0f) {
+        return Vector3(m[0] * point.x + m[1] * point.y + m[2] * point.z + m[3],
+          m[4] * point.x + m[5] * point.y + m[6] * point.z + m[7],
+          m[8] * point.x + m[9] * point.y + m[10] * point.z + m[11]);
+      }
+
       Vector4 temp(point.x, point.y, point.z, 1.0f);
       temp = (*this) * temp;
 
@@ -427,5 +508,44 @@ namespace EngineMath {
         0.0f, 0.0f, 1.0f, 0.0f,
 				0.0f, 0.0f, 0.0f, 1.0f);
     }
+
+#if defined(ENGINEMATH_SSE)
+  private:
+    /*
+      @brief Reorders the lanes of a register, lane i of the result is lane Li of v.
+		*/
+    template<int L0, int L1, int L2, int L3>
+    static __m128 
+      swizzle(__m128 v) {
+      return _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(v), _MM_SHUFFLE(L3, L2, L1, L0)));
+    }
+
+    /*
+      @brief 2x2 product a * b, blocks stored as (m00, m01, m10, m11).
+		*/
+    static __m128 
+      mat2Mul(__m128 a, __m128 b) {
+      return _mm_add_ps(_mm_mul_ps(a, swizzle<0, 3, 0, 3>(b)),
+        _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+    }
+
+    /*
+      @brief 2x2 product adj(a) * b.
+		*/
+    static __m128 
+      mat2AdjMul(__m128 a, __m128 b) {
+      return _mm_sub_ps(_mm_mul_ps(swizzle<3, 3, 0, 0>(a), b),
+        _mm_mul_ps(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b)));
+    }
+
+    /*
+      @brief 2x2 product a * adj(b).
+		*/
+    static __m128 
+      mat2MulAdj(__m128 a, __m128 b) {
+      return _mm_sub_ps(_mm_mul_ps(a, swizzle<3, 0, 3, 0>(b)),
+        _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+    }
+#endif
   };
 } // namespace EngineMath
\ No newline at end of file
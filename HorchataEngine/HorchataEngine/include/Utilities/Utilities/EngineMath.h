@@ -1,29 +1,223 @@
 #pragma once
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+// Scalar SSE is part of every x64 target; 32-bit MSVC needs /arch:SSE2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINEMATH_SSE 1
+#include <emmintrin.h>
+#endif
+
+// Wider batch kernels when the project is built with /arch:AVX or -mavx
+#if defined(__AVX__)
+#define ENGINEMATH_AVX 1
+#include <immintrin.h>
+#endif
+
 namespace EngineMath {
 	
 	// onstants for mathematical operations
 	const float PI = 3.14159265358979323846f;
 	const float EPSILON = 1.192092896e-07f;
 
+	namespace detail {
+		// Cody-Waite splits: the high part is exact in float, so x - k * HI has no rounding error
+		constexpr float LN2_HI = 0.693359375f;
+		constexpr float LN2_LO = -2.12194440e-4f;
+		constexpr float LOG2E = 1.44269504088896341f;
+		constexpr double PIO2 = 1.57079632679489661923;
+		constexpr double TWO_OVER_PI = 0.63661977236758134308;
+
+		// Bits of 2/PI after the binary point, behind one zero word, for the reduction of large angles
+		constexpr uint32_t TWO_OVER_PI_BITS[] = {
+			0x00000000u, 0xA2F9836Eu, 0x4E441529u, 0xFC2757D1u, 0xF534DDC0u,
+			0xDB629599u, 0x3C439041u, 0xFE5163ABu, 0xDEBBC561u
+		};
+
+		// exp(x) and log(x) are finite only inside these bounds
+		constexpr float EXP_MAX = 88.7228391f;
+		constexpr float EXP_MIN = -103.972084f;
+
+		/*
+			@brief Reinterprets the bits of a float as an integer.
+		*/
+		inline uint32_t
+			floatBits(float value) {
+				uint32_t bits;
+				std::memcpy(&bits, &value, sizeof(bits));
+				return bits;
+			}
+
+		/*
+			@brief Reinterprets an integer as the bits of a float.
+		*/
+		inline float
+			bitsFloat(uint32_t bits) {
+				float value;
+				std::memcpy(&value, &bits, sizeof(value));
+				return value;
+			}
+
+		/*
+			@brief Minimax polynomial for sin(r) on [-PI/4, PI/4], error below 1 ulp.
+		*/
+		constexpr float
+			sinKernel(float r) {
+				float z = r * r;
+				return ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * r + r;
+			}
+
+		/*
+			@brief Minimax polynomial for cos(r) on [-PI/4, PI/4], error below 1 ulp.
+		*/
+		constexpr float
+			cosKernel(float r) {
+				float z = r * r;
+				return ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z
+					- 0.5f * z + 1.0f;
+			}
+
+		/*
+			@brief Minimax polynomial for exp(r) on [-ln2/2, ln2/2].
+		*/
+		constexpr float
+			expKernel(float r) {
+				float p = 1.9875691500e-4f;
+				p = p * r + 1.3981999507e-3f;
+				p = p * r + 8.3334519073e-3f;
+				p = p * r + 4.1665795894e-2f;
+				p = p * r + 1.6666665459e-1f;
+				p = p * r + 5.0000001201e-1f;
+				return p * r * r + r + 1.0f;
+			}
+
+		/*
+			@brief log(m) for a mantissa m in [sqrt(0.5), sqrt(2)) with exponent e, so the
+			result is log(m * 2^e). Minimax polynomial in (m - 1).
+		*/
+		constexpr float
+			logKernel(float m, float e) {
+				float x = m - 1.0f;
+				float z = x * x;
+				float p = 7.0376836292e-2f;
+				p = p * x - 1.1514610310e-1f;
+				p = p * x + 1.1676998740e-1f;
+				p = p * x - 1.2420140846e-1f;
+				p = p * x + 1.4249322787e-1f;
+				p = p * x - 1.6668057665e-1f;
+				p = p * x + 2.0000714765e-1f;
+				p = p * x - 2.4999993993e-1f;
+				p = p * x + 3.3333331174e-1f;
+				float y = x * z * p;
+				y += e * LN2_LO;
+				y -= 0.5f * z;
+				return x + y + e * LN2_HI;
+			}
+
+		/*
+			@brief Reads 32 bits of TWO_OVER_PI_BITS starting at a bit index of the table.
+		*/
+		constexpr uint32_t
+			twoOverPiWord(int first) {
+				const int word = first / 32;
+				const int shift = first % 32;
+				const uint32_t high = TWO_OVER_PI_BITS[word];
+				return shift == 0 ? high : (high << shift) | (TWO_OVER_PI_BITS[word + 1] >> (32 - shift));
+			}
+
+		/*
+			@brief Payne-Hanek reduction for finite |x| >= 2^23, where subtracting n * PI/2
+			in double would lose the low bits of r.
+			Writing |x| = m * 2^s with an integer m below 2^24, only 96 bits of 2/PI
+			around bit s affect (|x| * 2/PI) mod 4, so they are multiplied with m in
+			fixed point (62 fraction bits, wrapping mod 4).
+		*/
+		constexpr float
+			reduceQuadrantLarge(float value, int& quadrant) {
+				double m = value < 0.0f ? -static_cast<double>(value) : static_cast<double>(value);
+				int s = 0;
+				while (m >= 16777216.0) { m *= 0.5; ++s; }
+				const uint64_t mantissa = static_cast<uint64_t>(m);
+
+				// The bit of weight 2 in 2/PI * 2^s is bit s - 2 after the point, s + 30 in the table
+				const int first = s + 30;
+				const uint64_t high = (static_cast<uint64_t>(twoOverPiWord(first)) << 32) | twoOverPiWord(first + 32);
+				const uint64_t low = twoOverPiWord(first + 64);
+				const uint64_t product = mantissa * high + ((mantissa * low) >> 32);
+
+				// Round to the nearest quadrant, what is left is r / (PI / 2) in [-0.5, 0.5)
+				const uint64_t n = (product + (uint64_t(1) << 61)) >> 62;
+				const int64_t fraction = static_cast<int64_t>(product - (n << 62));
+				const double r = static_cast<double>(fraction) * (PIO2 / 4611686018427387904.0);
+				if (value < 0.0f) {
+					quadrant = static_cast<int>((0 - n) & 3);
+					return static_cast<float>(-r);
+				}
+				quadrant = static_cast<int>(n & 3);
+				return static_cast<float>(r);
+			}
+
+		/*
+			@brief Shared by sin and cos: reduces x to r in [-PI/4, PI/4] plus a quadrant.
+			Below 2^23 the reduction runs in double, which keeps it exact for any angle a
+			game uses; larger angles go through reduceQuadrantLarge.
+		*/
+		constexpr float
+			reduceQuadrant(float value, int& quadrant) {
+				if (!(value > -8388608.0f && value < 8388608.0f)) {
+					return reduceQuadrantLarge(value, quadrant);
+				}
+				double x = static_cast<double>(value);
+				double k = x * TWO_OVER_PI;
+				long long n = static_cast<long long>(k >= 0.0 ? k + 0.5 : k - 0.5);
+				quadrant = static_cast<int>(n & 3);
+				return static_cast<float>(x - static_cast<double>(n) * PIO2);
+			}
+	} // namespace detail
+
 	/*
 		@brief Computes the square root of a number.
-		Uses the Newton-Raphson method for approximation.
+		Uses the hardware sqrtss instruction when SSE is available; otherwise an exponent
+		based estimate refined by three Newton-Raphson steps.
 		@param value The number to compute the square root of.
 		@return The square root of the number, or 0 if the input is negative or zero.
 	*/
 	inline float 
 		sqrt(float value) {
-			if (value < 0.0f) return 0.0f; // Handle negative input gracefully
-			if (value == 0.0f) return 0.0f; // Return 0 for zero input
+			if (!(value > 0.0f)) return 0.0f; // Negative, zero and NaN inputs return 0
+#if defined(ENGINEMATH_SSE)
+			return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(value)));
+#else
+			// Halving the exponent bits gives an estimate within ~4%, each step doubles the digits
+			float x = detail::bitsFloat((detail::floatBits(value) >> 1) + 0x1FC00000u);
+			x = 0.5f * (x + value / x);
+			x = 0.5f * (x + value / x);
+			x = 0.5f * (x + value / x);
+			return x;
+#endif
+		}
 
-			float x = value;
-			float y = 1.0f;
+	/*
+		@brief Compile-time square root.
+		Scales the input by powers of four into [1, 4) and runs Newton-Raphson there.
+		@param value The number to compute the square root of.
+		@return The square root of the number, or 0 if the input is negative or zero.
+	*/
+	constexpr float
+		constSqrt(float value) {
+			if (!(value > 0.0f)) return 0.0f;
+			if (value == std::numeric_limits<float>::infinity()) return value;
 
-			for (int i = 0; i < 10; ++i) // Fixed number of iterations for simplicity
-			{
+			float scale = 1.0f;
+			while (value >= 4.0f) { value *= 0.25f; scale *= 2.0f; }
+			while (value < 1.0f) { value *= 4.0f; scale *= 0.5f; }
+
+			float x = 0.5f * (value + 1.0f);
+			for (int i = 0; i < 5; ++i) {
 				x = 0.5f * (x + value / x);
 			}
-			return x;
+			return x * scale;
 		}
 
 	/*
@@ -68,7 +262,7 @@ namespace EngineMath {
 		@param value The number to compute the absolute value of.
 		@return The absolute value of the number.
 	*/
-	inline float 
+	constexpr float 
 		abs(float value) { return (value < 0.0f) ? -value : value; }
 
 	/*
@@ -145,44 +339,97 @@ namespace EngineMath {
 		}
 
 	/*
-		@brief Computes the sign of a float.
-		@param value The float to compute the sign of.
-		@return 1.0f if positive, -1.0f if negative, 0.0f if zero.
+		@brief Computes e raised to a value.
+		Splits value = k * ln2 + r with |r| <= ln2 / 2, evaluates a minimax polynomial for
+		exp(r) and puts k straight into the exponent bits.
+		@param value The exponent.
+		@return e^value; 0 below -103.97 and infinity above 88.72.
 	*/
 	inline float 
 		exp(float value)
 		{
-			float term = 1.0f;
-			float sum = 1.0f;
-			for (int i = 1; i < 15; ++i) // Fixed number of terms for simplicity
-			{
-				term *= (value / i); // Calculate term n! = n * (n-1) * ... * 1
-				sum += term;
+			if (value != value) return value; // NaN
+			if (value > detail::EXP_MAX) return std::numeric_limits<float>::infinity();
+			if (value < detail::EXP_MIN) return 0.0f;
+
+			float kf = value * detail::LOG2E;
+			int k = static_cast<int>(kf >= 0.0f ? kf + 0.5f : kf - 0.5f);
+			float r = value - static_cast<float>(k) * detail::LN2_HI - static_cast<float>(k) * detail::LN2_LO;
+			float result = detail::expKernel(r);
+
+			// 2^k in two steps so results in the denormal range are not flushed early
+			if (k < -126) {
+				result *= detail::bitsFloat(static_cast<uint32_t>(k + 126 + 127) << 23);
+				k = -126;
 			}
-			return sum;
+			return result * detail::bitsFloat(static_cast<uint32_t>(k + 127) << 23);
+		}
+
+	/*
+		@brief Compile-time version of exp; the power of two is built by repeated doubling.
+		@param value The exponent.
+		@return e^value; 0 below -103.97 and infinity above 88.72.
+	*/
+	constexpr float
+		constExp(float value)
+		{
+			if (value != value) return value;
+			if (value > detail::EXP_MAX) return std::numeric_limits<float>::infinity();
+			if (value < detail::EXP_MIN) return 0.0f;
+
+			float kf = value * detail::LOG2E;
+			int k = static_cast<int>(kf >= 0.0f ? kf + 0.5f : kf - 0.5f);
+			float r = value - static_cast<float>(k) * detail::LN2_HI - static_cast<float>(k) * detail::LN2_LO;
+			float result = detail::expKernel(r);
+			for (; k > 0; --k) result *= 2.0f;
+			for (; k < 0; ++k) result *= 0.5f;
+			return result;
 		}
 
 	/*
 		@brief Computes the natural logarithm of a value.
+		Splits value = m * 2^e with m in [sqrt(0.5), sqrt(2)) using the float bits and
+		evaluates a minimax polynomial for log(m).
 		@param value The value to compute the logarithm of.
 		@return The natural logarithm of the value, or -999999.0f for non-positive input.
 	*/
 	inline float 
 		log(float value)
 		{
-			if (value <= 0.0f) return -999999.0f; // Handle non-positive input gracefully
-			float xMinus1 = value - 1.0f;
-			float sum = 0.0f;
-			float term = xMinus1;
-			for (int i = 1; i < 15; ++i) // Fixed number of terms for simplicity
-			{
-				if (i % 2 == 1)
-					sum += (term / i); // Add odd terms
-				else
-					sum -= (term / i); // Subtract even terms
-				term *= xMinus1; // Update term for next iteration
+			if (!(value > 0.0f)) return -999999.0f; // Handle non-positive input gracefully
+			if (value == std::numeric_limits<float>::infinity()) return value;
+
+			int exponentBias = 0;
+			if (value < std::numeric_limits<float>::min()) {
+				value *= 8388608.0f; // Denormal: scale by 2^23 to get a normal mantissa
+				exponentBias = -23;
+			}
+
+			uint32_t bits = detail::floatBits(value);
+			int e = static_cast<int>((bits >> 23) & 0xFF) - 126 + exponentBias;
+			float m = detail::bitsFloat((bits & 0x007FFFFFu) | 0x3F000000u); // m in [0.5, 1)
+			if (m < 0.70710678f) { // Move m into the kernel's [sqrt(0.5), sqrt(2)) range
+				m *= 2.0f;
+				--e;
 			}
-			return sum; // Return the logarithm
+			return detail::logKernel(m, static_cast<float>(e));
+		}
+
+	/*
+		@brief Compile-time version of log; the exponent is found by repeated halving.
+		@param value The value to compute the logarithm of.
+		@return The natural logarithm of the value, or -999999.0f for non-positive input.
+	*/
+	constexpr float
+		constLog(float value)
+		{
+			if (!(value > 0.0f)) return -999999.0f;
+			if (value == std::numeric_limits<float>::infinity()) return value;
+
+			int e = 0;
+			while (value >= 1.41421356f) { value *= 0.5f; ++e; }
+			while (value < 0.70710678f) { value *= 2.0f; --e; }
+			return detail::logKernel(value, static_cast<float>(e));
 		}
 
 	/*
@@ -198,58 +445,44 @@ namespace EngineMath {
 
 	/*
 		@brief Computes the sine of an angle in radians.
+		Reduces the angle to [-PI/4, PI/4] and a quadrant, then evaluates a minimax
+		polynomial. Any finite angle is reduced exactly; NaN and infinity give NaN.
+		Usable in constant expressions.
 		@param value The angle in radians.
 		@return The sine of the angle.
 	*/
-	inline float 
+	constexpr float 
 		sin(float value)
 		{
-			value = mod(value, 2.0f * PI);
-			if (value > PI) value -= 2.0f * PI; // Normalize to [-PI, PI]
-			if (value < -PI) value += 2.0f * PI; // Normalize to [-PI, PI]
-
-			// Use Taylor series expansion for sine
-			float x = value;
-			float x2 = x * x;
-			float sum = x; // Start with the first term
-			float term = x; // Initialize term for sine series
-
-			term = -term * x2 / (3.0f * 2.0f * 1.0f); sum += term; // First term of sine series
-			term = -term * x2 / (5.0f * 4.0f); sum += term; // Second term of sine series
-			term = -term * x2 / (7.0f * 6.0f); sum += term; // Third term of sine series
-			term = -term * x2 / (9.0f * 8.0f); sum += term; // Fourth term of sine series
-			term = -term * x2 / (11.0f * 10.0f); sum += term; // Fifth term of sine series
-			term = -term * x2 / (13.0f * 12.0f); sum += term; // Sixth term of sine series
-
-			return sum;
+			if (!(abs(value) <= std::numeric_limits<float>::max())) return value - value; // NaN for NaN and infinity
+			int quadrant = 0;
+			float r = detail::reduceQuadrant(value, quadrant);
+			switch (quadrant) {
+			case 0: return detail::sinKernel(r);
+			case 1: return detail::cosKernel(r);
+			case 2: return -detail::sinKernel(r);
+			default: return -detail::cosKernel(r);
+			}
 		}
 
 	/*
 		@brief Computes the cosine of an angle in radians.
+		Same reduction as sin, shifted by one quadrant. Usable in constant expressions.
 		@param value The angle in radians.
 		@return The cosine of the angle.
 	*/
-	inline float 
+	constexpr float 
 		cos(float value)
 		{
-			value = mod(value, 2.0f * PI);
-			if (value > PI) value -= 2.0f * PI; // Normalize to [-PI, PI]
-			if (value < -PI) value += 2.0f * PI; // Normalize to [-PI, PI]
-
-			// Use Taylor series expansion for cosine
-			float x = value;
-			float x2 = x * x;
-			float sum = 1.0f; // Start with the first term
-			float term = 1.0f; // Initialize term for cosine series
-
-			term = -term * x2 / (2.0f * 1.0f); sum += term; // First term of cosine series
-			term = -term * x2 / (4.0f * 3.0f); sum += term; // Second term of cosine series
-			term = -term * x2 / (6.0f * 5.0f); sum += term; // Third term of cosine series
-			term = -term * x2 / (8.0f * 7.0f); sum += term; // Fourth term of cosine series
-			term = -term * x2 / (10.0f * 9.0f); sum += term; // Fifth term of cosine series
-			term = -term * x2 / (12.0f * 11.0f); sum += term; // Sixth term of cosine series
-
-			return sum;
+			if (!(abs(value) <= std::numeric_limits<float>::max())) return value - value;
+			int quadrant = 0;
+			float r = detail::reduceQuadrant(value, quadrant);
+			switch (quadrant) {
+			case 0: return detail::cosKernel(r);
+			case 1: return -detail::sinKernel(r);
+			case 2: return -detail::cosKernel(r);
+			default: return detail::sinKernel(r);
+			}
 		}
 
 	/*
@@ -257,7 +490,7 @@ namespace EngineMath {
 		@param value The angle in radians.
 		@return The tangent of the angle.
 	*/
-	inline float 
+	constexpr float 
 		tan(float value)
 		{
 			return sin(value) / cos(value); // Return tangent as sine over cosine
@@ -0,0 +1,221 @@
+#pragma once
+#include "../Utilities/EngineMath.h"
+#include "Vector2.h"
+#include "Vector4.h"
+#include "../Matrix/Matrix4x4.h"
+#include <cstddef>
+
+namespace EngineMath {
+	/*
+		@brief Batch kernels over contiguous arrays of vectors.
+		@details Each function takes a pointer and a count, so it works on std::vector data,
+		Registry columns or plain arrays. The SSE paths handle two Vector2 (or one Vector4)
+		per register, the AVX path of integratePositions four Vector2; the remainder and
+		builds without SIMD run the scalar loop.
+	*/
+	static_assert(sizeof(Vector2) == 2 * sizeof(float), "Batch kernels need Vector2 to be two packed floats");
+	static_assert(sizeof(Vector4) == 4 * sizeof(float), "Batch kernels need Vector4 to be four packed floats");
+
+	/*
+		@brief Advances positions by their velocities: positions[i] += velocities[i] * deltaTime.
+		@param positions Positions to update.
+		@param velocities Velocity of each position.
+		@param count Number of elements.
+		@param deltaTime Time step.
+	*/
+	inline void
+		integratePositions(Vector2* positions, const Vector2* velocities, size_t count, float deltaTime) {
+			float* p = &positions[0].x;
+			const float* v = &velocities[0].x;
+			const size_t floats = count * 2;
+			size_t i = 0;
+#if defined(ENGINEMATH_AVX)
+			const __m256 dt8 = _mm256_set1_ps(deltaTime);
+			for (; i + 8 <= floats; i += 8) {
+				_mm256_storeu_ps(p + i, _mm256_add_ps(_mm256_loadu_ps(p + i), _mm256_mul_ps(_mm256_loadu_ps(v + i), dt8)));
+			}
+#endif
+#if defined(ENGINEMATH_SSE)
+			const __m128 dt4 = _mm_set1_ps(deltaTime);
+			for (; i + 4 <= floats; i += 4) {
+				_mm_storeu_ps(p + i, _mm_add_ps(_mm_loadu_ps(p + i), _mm_mul_ps(_mm_loadu_ps(v + i), dt4)));
+			}
+#endif
+			for (; i < floats; ++i) {
+				p[i] += v[i] * deltaTime;
+			}
+		}
+
+	/*
+		@brief Normalizes every vector in place. Zero vectors stay zero, as in Vector2::normalize.
+		@param vectors Vectors to normalize.
+		@param count Number of elements.
+	*/
+	inline void
+		normalizeVectors(Vector2* vectors, size_t count) {
+			size_t i = 0;
+#if defined(ENGINEMATH_SSE)
+			const __m128 zero = _mm_setzero_ps();
+			for (; i + 4 <= count; i += 4) {
+				float* data = &vectors[i].x;
+				const __m128 a = _mm_loadu_ps(data);     // x0 y0 x1 y1
+				const __m128 b = _mm_loadu_ps(data + 4); // x2 y2 x3 y3
+				const __m128 xs = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+				const __m128 ys = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+				const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(xs, xs), _mm_mul_ps(ys, ys)));
+				// Lanes with zero length keep their (zero) values instead of dividing by zero
+				const __m128 valid = _mm_cmpneq_ps(length, zero);
+				const __m128 inverse = _mm_and_ps(valid, _mm_div_ps(_mm_set1_ps(1.0f), length));
+				const __m128 scale = _mm_or_ps(inverse, _mm_andnot_ps(valid, _mm_set1_ps(1.0f)));
+				_mm_storeu_ps(data, _mm_mul_ps(a, _mm_unpacklo_ps(scale, scale)));
+				_mm_storeu_ps(data + 4, _mm_mul_ps(b, _mm_unpackhi_ps(scale, scale)));
+			}
+#endif
+			for (; i < count; ++i) {
+				vectors[i].normalize();
+			}
+		}
+
+	/*
+		@brief Normalizes every 4D vector in place. Zero vectors stay zero.
+		@param vectors Vectors to normalize.
+		@param count Number of elements.
+	*/
+	inline void
+		normalizeVectors(Vector4* vectors, size_t count) {
+#if defined(ENGINEMATH_SSE)
+			for (size_t i = 0; i < count; ++i) {
+				float* data = &vectors[i].x;
+				const __m128 v = _mm_loadu_ps(data);
+				__m128 lengthSq = _mm_mul_ps(v, v);
+				lengthSq = _mm_add_ps(lengthSq, _mm_shuffle_ps(lengthSq, lengthSq, _MM_SHUFFLE(2, 3, 0, 1)));
+				lengthSq = _mm_add_ps(lengthSq, _mm_shuffle_ps(lengthSq, lengthSq, _MM_SHUFFLE(1, 0, 3, 2)));
+				if (_mm_cvtss_f32(lengthSq) != 0.0f) {
+					_mm_storeu_ps(data, _mm_div_ps(v, _mm_sqrt_ps(lengthSq)));
+				}
+			}
+#else
+			for (size_t i = 0; i < count; ++i) {
+				vectors[i].normalize();
+			}
+#endif
+		}
+
+	/*
+		@brief Computes the distance of every point to a target, e.g. all racers to a waypoint.
+		@param points Points to measure.
+		@param count Number of points.
+		@param target Common target point.
+		@param distances Output array with room for count floats.
+	*/
+	inline void
+		distancesTo(const Vector2* points, size_t count, const Vector2& target, float* distances) {
+			size_t i = 0;
+#if defined(ENGINEMATH_SSE)
+			const __m128 tx = _mm_set1_ps(target.x);
+			const __m128 ty = _mm_set1_ps(target.y);
+			for (; i + 4 <= count; i += 4) {
+				const float* data = &points[i].x;
+				const __m128 a = _mm_loadu_ps(data);
+				const __m128 b = _mm_loadu_ps(data + 4);
+				const __m128 dx = _mm_sub_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), tx);
+				const __m128 dy = _mm_sub_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)), ty);
+				_mm_storeu_ps(distances + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy))));
+			}
+#endif
+			for (; i < count; ++i) {
+				const float dx = points[i].x - target.x;
+				const float dy = points[i].y - target.y;
+				distances[i] = sqrt(dx * dx + dy * dy);
+			}
+		}
+
+	/*
+		@brief Computes the length of every vector.
+		@param vectors Vectors to measure.
+		@param count Number of vectors.
+		@param lengths Output array with room for count floats.
+	*/
+	inline void
+		vectorLengths(const Vector2* vectors, size_t count, float* lengths) {
+			size_t i = 0;
+#if defined(ENGINEMATH_SSE)
+			for (; i + 4 <= count; i += 4) {
+				const float* data = &vectors[i].x;
+				const __m128 a = _mm_loadu_ps(data);
+				const __m128 b = _mm_loadu_ps(data + 4);
+				const __m128 xs = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+				const __m128 ys = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+				_mm_storeu_ps(lengths + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(xs, xs), _mm_mul_ps(ys, ys))));
+			}
+#endif
+			for (; i < count; ++i) {
+				lengths[i] = sqrt(vectors[i].x * vectors[i].x + vectors[i].y * vectors[i].y);
+			}
+		}
+
+	/*
+		@brief Shortens every vector longer than its limit to that length, e.g. velocities to max speeds.
+		@param vectors Vectors to clamp in place.
+		@param maxLengths Limit of each vector.
+		@param count Number of vectors.
+	*/
+	inline void
+		clampLengths(Vector2* vectors, const float* maxLengths, size_t count) {
+			size_t i = 0;
+#if defined(ENGINEMATH_SSE)
+			const __m128 one = _mm_set1_ps(1.0f);
+			for (; i + 4 <= count; i += 4) {
+				float* data = &vectors[i].x;
+				const __m128 a = _mm_loadu_ps(data);
+				const __m128 b = _mm_loadu_ps(data + 4);
+				const __m128 xs = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+				const __m128 ys = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+				const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(xs, xs), _mm_mul_ps(ys, ys)));
+				const __m128 limit = _mm_loadu_ps(maxLengths + i);
+				// Lanes within their limit (zero length included) keep a scale of 1
+				const __m128 over = _mm_cmpgt_ps(length, limit);
+				const __m128 scale = _mm_or_ps(_mm_and_ps(over, _mm_div_ps(limit, length)), _mm_andnot_ps(over, one));
+				_mm_storeu_ps(data, _mm_mul_ps(a, _mm_unpacklo_ps(scale, scale)));
+				_mm_storeu_ps(data + 4, _mm_mul_ps(b, _mm_unpackhi_ps(scale, scale)));
+			}
+#endif
+			for (; i < count; ++i) {
+				const float length = sqrt(vectors[i].x * vectors[i].x + vectors[i].y * vectors[i].y);
+				if (length > maxLengths[i]) {
+					vectors[i] *= maxLengths[i] / length;
+				}
+			}
+		}
+
+	/*
+		@brief Multiplies every vector by a matrix: results[i] = matrix * vectors[i].
+		@param matrix The transformation.
+		@param vectors Input vectors.
+		@param results Output vectors, may be the same array as vectors.
+		@param count Number of elements.
+	*/
+	inline void
+		transformVectors(const Matrix4x4& matrix, const Vector4* vectors, Vector4* results, size_t count) {
+#if defined(ENGINEMATH_SSE)
+			// Columns of the row-major matrix, so each result is a sum of scaled columns
+			__m128 c0 = _mm_loadu_ps(matrix.m);
+			__m128 c1 = _mm_loadu_ps(matrix.m + 4);
+			__m128 c2 = _mm_loadu_ps(matrix.m + 8);
+			__m128 c3 = _mm_loadu_ps(matrix.m + 12);
+			_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+			for (size_t i = 0; i < count; ++i) {
+				const __m128 v = _mm_loadu_ps(&vectors[i].x);
+				__m128 r = _mm_mul_ps(c0, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+				r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+				r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+				r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))));
+				_mm_storeu_ps(&results[i].x, r);
+			}
+#else
+			for (size_t i = 0; i < count; ++i) {
+				results[i] = matrix * vectors[i];
+			}
+#endif
+		}
+} // namespace EngineMath
@@ -0,0 +1,319 @@
+#include "AssetCache.h"
+#include <filesystem>
+#include <cstring>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#define NOGDI // wingdi.h defines ERROR, which clashes with the engine macro
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+  constexpr uint32_t ENTRY_MAGIC = 0x43414348u; // "HCAC"
+  constexpr uint32_t ENTRY_VERSION = 1;
+
+  constexpr uint64_t PRIME1 = 11400714785074694791ull;
+  constexpr uint64_t PRIME2 = 14029467366897019727ull;
+  constexpr uint64_t PRIME3 = 1609587929392839161ull;
+  constexpr uint64_t PRIME4 = 9650029242287828579ull;
+  constexpr uint64_t PRIME5 = 2870177450012600261ull;
+
+  inline uint64_t
+    rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+  }
+
+  /**
+   * @brief Hash of a buffer with the xxHash64 mixing steps, one 64-bit lane.
+   * Every input bit reaches every output bit, unlike a plain multiply per word.
+   */
+  uint64_t
+    hashBytes(const uint8_t* bytes, size_t size) {
+    uint64_t hash = PRIME5 + size;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+      uint64_t word;
+      std::memcpy(&word, bytes + i, sizeof(word));
+      hash ^= rotateLeft(word * PRIME2, 31) * PRIME1;
+      hash = rotateLeft(hash, 27) * PRIME1 + PRIME4;
+    }
+    for (; i < size; ++i) {
+      hash ^= bytes[i] * PRIME5;
+      hash = rotateLeft(hash, 11) * PRIME1;
+    }
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+  }
+}
+
+MappedFile::~MappedFile() {
+  close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+  *this = std::move(other);
+}
+
+MappedFile&
+MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    close();
+    m_data = other.m_data;
+    m_size = other.m_size;
+    other.m_data = nullptr;
+    other.m_size = 0;
+#if defined(_WIN32)
+    m_fileHandle = other.m_fileHandle;
+    m_mappingHandle = other.m_mappingHandle;
+    other.m_fileHandle = nullptr;
+    other.m_mappingHandle = nullptr;
+#endif
+  }
+  return *this;
+}
+
+bool
+MappedFile::open(const std::string& fileName) {
+  close();
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+    CloseHandle(file);
+    return false;
+  }
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping) {
+    CloseHandle(file);
+    return false;
+  }
+  void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!view) {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+  m_fileHandle = file;
+  m_mappingHandle = mapping;
+  m_data = static_cast<const uint8_t*>(view);
+  m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+  int file = ::open(fileName.c_str(), O_RDONLY);
+  if (file < 0) {
+    return false;
+  }
+  struct stat info;
+  if (fstat(file, &info) != 0 || info.st_size == 0) {
+    ::close(file);
+    return false;
+  }
+  void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+  // The mapping stays valid after the descriptor is closed
+  ::close(file);
+  if (view == MAP_FAILED) {
+    return false;
+  }
+  m_data = static_cast<const uint8_t*>(view);
+  m_size = static_cast<size_t>(info.st_size);
+#endif
+  return true;
+}
+
+void
+MappedFile::close() {
+  if (!m_data) {
+    return;
+  }
+#if defined(_WIN32)
+  UnmapViewOfFile(m_data);
+  CloseHandle(m_mappingHandle);
+  CloseHandle(m_fileHandle);
+  m_fileHandle = nullptr;
+  m_mappingHandle = nullptr;
+#else
+  munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+  m_data = nullptr;
+  m_size = 0;
+}
+
+void
+AssetCache::setDirectory(const std::string& directory) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_directory = directory;
+}
+
+std::string
+AssetCache::getDirectory() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_directory;
+}
+
+uint64_t
+AssetCache::hashFile(const std::string& fileName) {
+  // An edited source gets a new size or modification time, and is hashed again
+  std::error_code error;
+  const uint64_t size = std::filesystem::file_size(fileName, error);
+  if (error) {
+    return 0;
+  }
+  const int64_t modifiedTime = std::filesystem::last_write_time(fileName, error).time_since_epoch().count();
+  if (error) {
+    return 0;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_hashes.find(fileName);
+    if (it != m_hashes.end() && it->second.size == size && it->second.modifiedTime == modifiedTime) {
+      return it->second.hash;
+    }
+  }
+
+  MappedFile file;
+  if (!file.open(fileName)) {
+    return 0;
+  }
+  uint64_t hash = hashBytes(file.data(), file.size());
+  hash = hash != 0 ? hash : 1;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_hashes[fileName] = { size, modifiedTime, hash };
+  return hash;
+}
+
+std::string
+AssetCache::entryPath(uint64_t sourceHash, const std::string& kind) const {
+  static const char digits[] = "0123456789abcdef";
+  std::string name(16, '0');
+  for (int i = 15; i >= 0; --i) {
+    name[i] = digits[sourceHash & 0xF];
+    sourceHash >>= 4;
+  }
+  return m_directory + "/" + name + "." + kind;
+}
+
+bool
+AssetCache::find(const std::string& sourceFile,
+                 const std::string& kind,
+                 MappedFile& file,
+                 const uint8_t*& payload,
+                 size_t& payloadSize) {
+  if (!m_enabled) {
+    return false;
+  }
+  const uint64_t sourceHash = hashFile(sourceFile);
+  if (sourceHash == 0) {
+    return false;
+  }
+
+  std::string path;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    path = entryPath(sourceHash, kind);
+  }
+  if (!file.open(path) || file.size() < sizeof(EntryHeader)) {
+    return false;
+  }
+
+  EntryHeader header;
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (header.magic != ENTRY_MAGIC || header.version != ENTRY_VERSION ||
+      header.sourceHash != sourceHash || header.payloadSize != file.size() - sizeof(EntryHeader)) {
+    file.close();
+    return false;
+  }
+
+  payload = file.data() + sizeof(EntryHeader);
+  payloadSize = static_cast<size_t>(header.payloadSize);
+  return true;
+}
+
+bool
+AssetCache::store(const std::string& sourceFile, const std::string& kind, const void* payload, size_t payloadSize) {
+  if (!m_enabled) {
+    return false;
+  }
+  const uint64_t sourceHash = hashFile(sourceFile);
+  if (sourceHash == 0) {
+    return false;
+  }
+
+  std::string path;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    path = entryPath(sourceHash, kind);
+  }
+
+  std::error_code error;
+  std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+  const std::string temporaryPath = path + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+  {
+    std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+    if (!output) {
+      // The cache is optional: the caller keeps the decoded data and the next run rebuilds it
+      std::cerr << "[AssetCache] Can't write the cache entry: " << path << ". Continuing without it.\n";
+      return false;
+    }
+    EntryHeader header{ ENTRY_MAGIC, ENTRY_VERSION, sourceHash, static_cast<uint64_t>(payloadSize) };
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(static_cast<const char*>(payload), static_cast<std::streamsize>(payloadSize));
+    if (!output) {
+      std::cerr << "[AssetCache] Can't write the cache entry: " << path << ". Continuing without it.\n";
+      output.close();
+      std::filesystem::remove(temporaryPath, error);
+      return false;
+    }
+  }
+
+  std::filesystem::rename(temporaryPath, path, error);
+  if (error) {
+    std::filesystem::remove(temporaryPath, error);
+    return false;
+  }
+  return true;
+}
+
+bool
+AssetCache::loadImage(const std::string& sourceFile, sf::Image& image) {
+  // Payload: width, height, then width * height RGBA pixels
+  MappedFile file;
+  const uint8_t* payload = nullptr;
+  size_t payloadSize = 0;
+  if (find(sourceFile, "rgba", file, payload, payloadSize) && payloadSize >= 2 * sizeof(uint32_t)) {
+    uint32_t size[2];
+    std::memcpy(size, payload, sizeof(size));
+    if (payloadSize == sizeof(size) + static_cast<size_t>(size[0]) * size[1] * 4) {
+      image.resize(sf::Vector2u(size[0], size[1]), payload + sizeof(size));
+      return true;
+    }
+  }
+
+  if (!image.loadFromFile(sourceFile)) {
+    return false;
+  }
+
+  const uint32_t size[2] = { image.getSize().x, image.getSize().y };
+  const size_t pixelBytes = static_cast<size_t>(size[0]) * size[1] * 4;
+  std::vector<uint8_t> blob(sizeof(size) + pixelBytes);
+  std::memcpy(blob.data(), size, sizeof(size));
+  if (pixelBytes > 0) {
+    std::memcpy(blob.data() + sizeof(size), image.getPixelsPtr(), pixelBytes);
+  }
+  store(sourceFile, "rgba", blob.data(), blob.size());
+  return true;
+}
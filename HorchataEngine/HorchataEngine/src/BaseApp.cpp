@@ -1,5 +1,7 @@
 #include <BaseApp.h>
 #include <ResourceManager.h>
+#include <Profiler.h>
+#include <AssetCache.h>
 
 BaseApp::~BaseApp() {}
 
@@ -10,20 +12,64 @@ BaseApp::run() {
       "Initializes result on a false statement, check method validations");
   }
 
+  Profiler& profiler = Profiler::getInstance();
+  profiler.setThreadName("Main");
+  EngineUtilities::MemoryTracker& memoryTracker = EngineUtilities::MemoryTracker::getInstance();
+  memoryTracker.resetFrameStats(); // Loading allocations do not count as a frame
+
   while (m_windowPtr->isOpen()) {
+    profiler.beginFrame();
     m_windowPtr->handleEvents(m_engineGUI);
+    ResourceManager::getInstance().processUploads();
     update();
     render();
+
+    // Transient allocations of this frame are released all at once
+    EngineUtilities::FrameArena::getInstance().reset();
+    Registry::getInstance().reportMemoryUsage();
+    memoryTracker.endFrame();
+    profiler.endFrame();
+  }
+
+  destroy();
+  return 0;
+}
+
+int
+BaseApp::runHeadless(size_t frameCount, float fixedDeltaTime) {
+  m_headless = true;
+  Profiler::getInstance().setThreadName("Main");
+  if (!initScene()) {
+    ERROR("BaseApp", "runHeadless",
+      "Scene initialization failed, check method validations");
+    return 1;
   }
 
+  // No window, no GUI, no frame limit: step the systems as fast as possible
+  EngineUtilities::MemoryTracker& memoryTracker = EngineUtilities::MemoryTracker::getInstance();
+  memoryTracker.resetFrameStats();
+  sf::Clock wallClock;
+  for (size_t frame = 0; frame < frameCount; ++frame) {
+    stepSimulation(fixedDeltaTime);
+    EngineUtilities::FrameArena::getInstance().reset();
+    memoryTracker.endFrame();
+  }
+  Registry::getInstance().reportMemoryUsage();
+  const float wallSeconds = wallClock.getElapsedTime().asSeconds();
+
+  std::cout << "[BaseApp] Headless run: " << frameCount << " frames, "
+            << frameCount * fixedDeltaTime << " s simulated in "
+            << wallSeconds << " s ("
+            << (wallSeconds > 0.f ? frameCount / wallSeconds : 0.f) << " frames/s)\n";
+  std::cout << "[BaseApp] Allocations: " << memoryTracker.getMaxFrameAllocations()
+            << " max per frame, " << memoryTracker.getPeakBytes() << " bytes peak\n";
+
   destroy();
   return 0;
 }
 
 bool
 BaseApp::init() {
-	ResourceManager& resourceMan = ResourceManager::getInstance();
-
 	m_windowPtr = EngineUtilities::MakeShared<Window>(1920, 1080, "Horchata Engine");
   if (!m_windowPtr) {
     ERROR("BaseApp", 
@@ -33,8 +79,14 @@ BaseApp::init() {
 	}
 
 	m_engineGUI.init(m_windowPtr);
+	return initScene();
+}
+
+bool
+BaseApp::initScene() {
+	ResourceManager& resourceMan = ResourceManager::getInstance();
 
-	m_waypoints = {
+	m_path = EngineUtilities::MakeShared<Path>(std::vector<EngineMath::Vector2>{
 		EngineMath::Vector2(510.f, 22.f),
 		EngineMath::Vector2(850.f, 22.f),
 		EngineMath::Vector2(1190.f, 22.f),
@@ -57,19 +109,28 @@ BaseApp::init() {
 		EngineMath::Vector2(510.f, 875.f),
 		EngineMath::Vector2(510.f, 700.f),
 		EngineMath::Vector2(510.f, 500.f),
-	};
+	});
+	const EngineMath::Vector2 startPosition = m_path->getPoint(m_path->getPointCount() - 1);
+
+	// Kart sprites share one atlas page so the SpriteBatch draws them in one call;
+	// the packed page is cached next to the AssetCache entries and reused while the sprites do not change
+	if (!m_headless) {
+		if (!resourceMan.buildAtlas({ "Sprites/Mario", "Sprites/Luigi" }, "png",
+		                            AssetCache::getInstance().getDirectory() + "/karts.atlas")) {
+			MESSAGE("BaseApp", "init", "Can't load every kart texture");
+		}
+	}
 
 	m_Aplayer = EngineUtilities::MakeShared<APlayer>("Player");
 	if (m_Aplayer) {
 		m_Aplayer->getComponent<CShape>()->createShape(ShapeType::RECTANGLE);
 		m_Aplayer->getComponent<CShape>()->setFillColor(sf::Color::White);
-		m_Aplayer->getComponent<Transform>()->setPosition(m_waypoints.back());
+		m_Aplayer->getComponent<Transform>()->setPosition(startPosition);
 		m_Aplayer->getComponent<Transform>()->setScale(EngineMath::Vector2(1.f, 2.f) / 3.f);
 
-		if (!resourceMan.loadTexture("Sprites/Mario", "png")) {
-			MESSAGE("BaseApp", "init", "Can't load the texture");
+		if (!m_headless) {
+			m_Aplayer->setTexture(resourceMan.getTextureRegion("Sprites/Mario"));
 		}
-		m_Aplayer->setTexture(resourceMan.getTexture("Sprites/Mario"));
 		m_actors.push_back(m_Aplayer);
 	}
 	else {
@@ -85,22 +146,24 @@ BaseApp::init() {
 			"Sprites/Luigi"
 	};
 
+	// The same behaviors for every bot, so SteeringSystem runs them as a single group
+	EngineUtilities::TSharedPointer<SteeringBehavior> pathFollowing = EngineUtilities::MakeShared<PathFollowing>(m_path);
+
 	for (int i = 0; i < 5; ++i) {
-		EngineUtilities::TSharedPointer<ARacer> racer = EngineUtilities::MakeShared<ARacer>("Bot " + std::to_string(i + 1));
+		EngineUtilities::TSharedPointer<ARacer> racer = EngineUtilities::MakeSharedPooled<ARacer>("Bot " + std::to_string(i + 1));
 		if (racer) {
 			racer->getComponent<CShape>()->createShape(ShapeType::RECTANGLE);
 			racer->getComponent<CShape>()->setFillColor(sf::Color::White); // Rojo semi-transparente
-			racer->getComponent<Transform>()->setPosition(m_waypoints.back() - EngineMath::Vector2(0, (i + 1) * 30.f));
+			racer->getComponent<Transform>()->setPosition(startPosition - EngineMath::Vector2(0, (i + 1) * 30.f));
 			racer->getComponent<Transform>()->setScale(EngineMath::Vector2(1.f, 2.f) / 3.f);
 
 			// Cargar y asignar textura nica para cada bot
-			if (!resourceMan.loadTexture(botTextures[i], "png")) {
-				MESSAGE("BaseApp", "init", "Can't load the bot texture: " + botTextures[i]);
+			if (!m_headless) {
+				racer->setTexture(resourceMan.getTextureRegion(botTextures[i]));
 			}
-			racer->setTexture(resourceMan.getTexture(botTextures[i]));
 
 			// Aade el Steering Behavior de PathFollowing
-			racer->addSteeringBehavior(EngineUtilities::MakeShared<PathFollowing>(m_waypoints));
+			racer->addSteeringBehavior(pathFollowing);
 
 			m_Aracers.push_back(racer);
 			m_actors.push_back(racer);
@@ -118,10 +181,10 @@ BaseApp::init() {
 		m_ATrack->getComponent<Transform>()->setPosition(EngineMath::Vector2(500.f, 50.f));
 		m_ATrack->getComponent<Transform>()->setScale(EngineMath::Vector2(10.f, 20.f));
 
-		if (!resourceMan.loadTexture("Sprites/Rainbow_Road", "png")) {
-			MESSAGE("BaseApp", "init", "Can't load the texture");
+		// Too big for the atlas: decodes on the ThreadPool, placeholder until uploaded
+		if (!m_headless) {
+			m_ATrack->setTexture(resourceMan.acquireTexture("Sprites/Rainbow_Road", "png"));
 		}
-		m_ATrack->setTexture(resourceMan.getTexture("Sprites/Rainbow_Road"));
 		m_actors.push_back(m_ATrack);
 	}
 	else {
@@ -131,39 +194,119 @@ BaseApp::init() {
 
 	m_gameManager = EngineUtilities::MakeShared<GameManager>();
 	if (m_gameManager) {
-		m_gameManager->init(m_ATrack, m_waypoints);
+		// The collision mask is read from the image file, so it also works headless
+		m_gameManager->init(m_ATrack, m_path, "Sprites/Rainbow_Road.png");
 	}
 	else {
 		ERROR("BaseApp", "init", "Failed to create GameManager, check memory allocation");
 		return false;
 	}
 
+	// Keeping off the walls comes first, then room from the other karts, then the path
+	EngineUtilities::TSharedPointer<SteeringBehavior> wallAvoidance = EngineUtilities::MakeShared<WallAvoidance>(m_gameManager->getTrackMask());
+	EngineUtilities::TSharedPointer<SteeringBehavior> separation = EngineUtilities::MakeShared<Separation>(40.f);
+	for (auto& racer : m_Aracers) {
+		racer->addSteeringBehavior(wallAvoidance, 1.f, 2);
+		racer->addSteeringBehavior(separation, 1.f, 1);
+	}
+
+	registerSystems();
+
+	// Spawn positions are also the previous state, so the first frame does not blend from the origin
+	Actor::storePreviousTransforms();
 	return true;
 }
 
+void
+BaseApp::registerSystems() {
+	// Racer and player state are declared by actor type, positions by Transform.
+	// GameManager, PlayerMovement and RacerCollision all write Transform, and
+	// Steering reads the player velocity that Input writes, so every system
+	// runs in its own stage.
+	m_scheduler.addSystem("GameManager",
+		resourceMask<>(),
+		resourceMask<ARacer, APlayer, Transform>(),
+		[this](float deltaTime) {
+			m_gameManager->update(deltaTime, m_Aracers, m_Aplayer);
+		});
+
+	// Headless runs have no keyboard, the player kart just stays idle
+	if (!m_headless) {
+		m_scheduler.addSystem("Input",
+			resourceMask<>(),
+			resourceMask<APlayer>(),
+			[this](float deltaTime) {
+				m_Aplayer->handleInput(deltaTime);
+			},
+			true);
+	}
+
+	m_scheduler.addSystem("Steering",
+		resourceMask<APlayer>(),
+		resourceMask<ARacer, Transform>(),
+		[this](float deltaTime) {
+			// The player is not steered, but the racers keep their distance from it
+			m_steeringNeighbors.clear();
+			m_steeringNeighbors.push_back(SteeringSystem::NeighborKart{
+				m_Aplayer->getComponent<Transform>()->getPosition(), m_Aplayer->getVelocity() });
+			m_steeringSystem.update(m_Aracers, deltaTime, m_steeringNeighbors);
+		});
+
+	m_scheduler.addSystem("PlayerMovement",
+		resourceMask<APlayer>(),
+		resourceMask<Transform>(),
+		[this](float deltaTime) {
+			m_Aplayer->move(deltaTime);
+		});
+
+	m_scheduler.addSystem("RacerCollision",
+		resourceMask<>(),
+		resourceMask<Transform>(),
+		[this](float) {
+			m_gameManager->resolveRacerCollisions(m_Aracers, m_Aplayer);
+		});
+}
+
+void
+BaseApp::stepSimulation(float deltaTime) {
+	// Game manager, input, steering and collisions, see registerSystems
+	Actor::storePreviousTransforms();
+	m_scheduler.run(deltaTime);
+}
+
 void
 BaseApp::update() {
+  PROFILE_SCOPE("BaseApp::update");
   if (!m_windowPtr.isNull()) {
 		m_windowPtr->update();
 	}
 	
-	// Actualizar el game manager y los actores
-	m_gameManager->update(m_windowPtr->deltaTime.asSeconds(), m_Aracers, m_Aplayer);
-
-	for (const auto& actor : m_actors) {
-		if (actor) {
-			actor->update(m_windowPtr->deltaTime.asSeconds());
-		}
+	// Fixed simulation steps for the time that passed; a long frame is clamped
+	// so a spike costs a bounded number of steps
+	float frameTime = m_windowPtr->deltaTime.asSeconds();
+	m_accumulator += frameTime < m_maxFrameTime ? frameTime : m_maxFrameTime;
+	while (m_accumulator >= m_fixedDeltaTime) {
+		stepSimulation(m_fixedDeltaTime);
+		m_accumulator -= m_fixedDeltaTime;
 	}
 
-	m_engineGUI.update(m_windowPtr, m_windowPtr->deltaTime);
-	m_engineGUI.outliner(m_actors);
-	m_engineGUI.inspector(m_actors);
+	// Shapes show the state between the last two steps
+	Actor::syncTransforms(m_accumulator / m_fixedDeltaTime);
+
+	{
+		PROFILE_SCOPE("EngineGUI::update");
+		m_engineGUI.update(m_windowPtr, m_windowPtr->deltaTime);
+		m_engineGUI.outliner(m_actors);
+		m_engineGUI.inspector(m_actors);
+		m_engineGUI.profiler(m_spriteBatch.getStats());
+		m_engineGUI.memory();
+	}
 	//ImGui::ShowDemoWindow();
 }
 
 void
 BaseApp::render() {
+  PROFILE_SCOPE("BaseApp::render");
   if (!m_windowPtr) {
     return;
     //m_windowPtr->draw(*m_shapePtr);
@@ -171,30 +314,43 @@ BaseApp::render() {
 
   m_windowPtr->clear();
 
+  // Track on layer 0 under the karts; one draw call per texture
+  m_spriteBatch.begin();
   if(!m_ATrack.isNull()) {
-    m_ATrack->getComponent<CShape>()->render(m_windowPtr);
+    m_ATrack->getComponent<CShape>()->submit(m_spriteBatch, 0);
 	}
 
 	if (!m_Aplayer.isNull()) {
-		m_Aplayer->getComponent<CShape>()->render(m_windowPtr);
+		m_Aplayer->getComponent<CShape>()->submit(m_spriteBatch, 1);
 	}
 
 	for (const auto& racer : m_Aracers) {
 		if (!racer.isNull()) {
-			racer->getComponent<CShape>()->render(m_windowPtr);
+			racer->getComponent<CShape>()->submit(m_spriteBatch, 1);
 		}
 	}
+	{
+		PROFILE_SCOPE("SpriteBatch::flush");
+		m_spriteBatch.flush(m_windowPtr);
+	}
 
 	m_gameManager->renderHUD(m_windowPtr);
 	m_windowPtr->render();
-  m_engineGUI.render(m_windowPtr);
-  m_windowPtr->display();
+  {
+    PROFILE_SCOPE("EngineGUI::render");
+    m_engineGUI.render(m_windowPtr);
+  }
+  {
+    PROFILE_SCOPE("Window::display");
+    m_windowPtr->display();
+  }
 }
 
 void
 BaseApp::destroy() {
-
-  m_engineGUI.destroy();
+  if (!m_headless) {
+    m_engineGUI.destroy();
+  }
 	//m_shapePtr.reset(); // Release the shape pointer
   //m_window->destroy();
 }
@@ -1,6 +1,8 @@
 #include "CShape.h"
 #include "Window.h"
 #include "ECS/Texture.h"
+#include "SpriteBatch.h"
+#include "ResourceManager.h"
 
 void
 CShape::createShape(ShapeType type) {
@@ -12,14 +14,14 @@ CShape::createShape(ShapeType type) {
     //m_shape = circle;
     //m_shapePtr.reset(new sf::CircleShape(10.f));
     //return circle;
-    auto circleSP = EngineUtilities::MakeShared<sf::CircleShape>(10.f);
+    auto circleSP = EngineUtilities::MakeSharedPooled<sf::CircleShape>(10.f);
 		circleSP->setFillColor(sf::Color::White);
 		m_shapePtr = circleSP.dynamic_pointer_cast<sf::Shape>();
 		break;
   }
 
   case ShapeType::RECTANGLE: {
-    auto rectSP = EngineUtilities::MakeShared<sf::RectangleShape>(
+    auto rectSP = EngineUtilities::MakeSharedPooled<sf::RectangleShape>(
 		sf::Vector2f(100.f, 50.f));
 		rectSP->setFillColor(sf::Color::White);
 		m_shapePtr = rectSP.dynamic_pointer_cast<sf::Shape>();
@@ -27,7 +29,7 @@ CShape::createShape(ShapeType type) {
   }
 
   case ShapeType::TRIANGLE: {
-		auto triSP = EngineUtilities::MakeShared<sf::ConvexShape>(3);
+		auto triSP = EngineUtilities::MakeSharedPooled<sf::ConvexShape>(3);
     triSP->setPoint(0, {0, 0});
     triSP->setPoint(1, {50, 100});
     triSP->setPoint(2, {100, 0});
@@ -37,7 +39,7 @@ CShape::createShape(ShapeType type) {
   }
 
   case ShapeType::POLYGON: {
-		auto polySP = EngineUtilities::MakeShared<sf::ConvexShape>(5);
+		auto polySP = EngineUtilities::MakeSharedPooled<sf::ConvexShape>(5);
     polySP->setPoint(0, {0, 0});
     polySP->setPoint(1, {50, 100});
     polySP->setPoint(2, {100, 0});
@@ -68,10 +70,19 @@ CShape::update(float deltaTime) {
 void
 CShape::render(const EngineUtilities::TSharedPointer<Window>& window) {
   if (m_shapePtr) {
+    refreshTexture();
     window->draw(*m_shapePtr);
   }
 }
 
+void
+CShape::submit(SpriteBatch& spriteBatch, int layer) const {
+  if (m_shapePtr) {
+    refreshTexture();
+    spriteBatch.submit(*m_shapePtr, layer);
+  }
+}
+
 void
 CShape::destroy() {
   
@@ -111,5 +122,48 @@ void
 CShape::setTexture(const EngineUtilities::TSharedPointer<Texture>& texture) {
   if (!texture.isNull()) {
     m_shapePtr->setTexture(&texture->getTexture());
+    m_texture = texture;
+    m_textureRevision = texture->getRevision();
+    m_textureRect = sf::IntRect();
+    m_textureHandle = TextureHandle();
+  }
+}
+
+void
+CShape::setTexture(const TextureRegion& region) {
+  if (region.texture.isNull()) {
+    return;
   }
-}
\ No newline at end of file
+  if (region.rect.size.x == 0 || region.rect.size.y == 0) {
+    setTexture(region.texture);
+    m_textureHandle = region.handle;
+    return;
+  }
+  m_shapePtr->setTexture(&region.texture->getTexture());
+  m_shapePtr->setTextureRect(region.rect);
+  m_texture = region.texture;
+  m_textureRevision = region.texture->getRevision();
+  m_textureRect = region.rect;
+  m_textureHandle = region.handle;
+}
+
+void
+CShape::refreshTexture() const {
+  if (m_textureHandle.isValid()) {
+    ResourceManager::getInstance().touchTexture(m_textureHandle);
+  }
+  if (m_texture && m_texture->getRevision() != m_textureRevision) {
+    // Atlas regions keep their rect, whole textures take the new size
+    const bool wholeTexture = m_textureRect.size.x == 0 || m_textureRect.size.y == 0;
+    m_shapePtr->setTexture(&m_texture->getTexture(), wholeTexture);
+    if (!wholeTexture) {
+      m_shapePtr->setTextureRect(m_textureRect);
+    }
+    m_textureRevision = m_texture->getRevision();
+  }
+}
+
+sf::FloatRect
+CShape::getLocalBounds() const {
+  return m_shapePtr ? m_shapePtr->getLocalBounds() : sf::FloatRect();
+}
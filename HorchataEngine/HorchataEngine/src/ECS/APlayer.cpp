@@ -1,4 +1,5 @@
 #include "ECS/APlayer.h"
+#include <cmath>
 
 APlayer::APlayer(const std::string& name) : Actor(name)
 {
@@ -8,17 +9,17 @@ APlayer::APlayer(const std::string& name) : Actor(name)
 void APlayer::update(float deltaTime)
 {
 	handleInput(deltaTime);
+	move(deltaTime);
 	Actor::update(deltaTime);
 }
 
 void APlayer::handleInput(float deltaTime)
 {
-	EngineUtilities::TSharedPointer<Transform> transform = getComponent<Transform>();
-	if (!transform) return;
-
-	// Apply friction for smooth deceleration
-	m_velocity.x *= m_friction;
-	m_velocity.y *= m_friction;
+	// Apply friction for smooth deceleration. m_friction is the factor per 1/60 s, so the
+	// feel doesn't depend on the simulation step
+	const float friction = std::pow(m_friction, deltaTime * 60.f);
+	m_velocity.x *= friction;
+	m_velocity.y *= friction;
 
 	// Accelerate and decelerate with the arrow keys
 	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Up)) {
@@ -39,8 +40,13 @@ void APlayer::handleInput(float deltaTime)
 	if (currentSpeed > m_maxSpeed) {
 		m_velocity = m_velocity.normalized() * m_maxSpeed;
 	}
+}
+
+void APlayer::move(float deltaTime)
+{
+	Transform* transform = getComponent<Transform>();
+	if (!transform) return;
 
-	// Move the player
 	EngineMath::Vector2 currentPos = transform->getPosition();
 	transform->setPosition(currentPos + m_velocity * deltaTime);
 }
@@ -50,6 +56,11 @@ void APlayer::setCurrentWaypointIndex(size_t index)
 	m_currentWaypointIndex = index;
 }
 
+const EngineMath::Vector2& APlayer::getVelocity() const
+{
+	return m_velocity;
+}
+
 size_t APlayer::getCurrentWaypointIndex() const
 {
 	return m_currentWaypointIndex;
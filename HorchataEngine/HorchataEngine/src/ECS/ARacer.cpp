@@ -1,4 +1,6 @@
 #include "ECS/ARacer.h"
+#include "Profiler.h"
+#include <algorithm>
 
 ARacer::ARacer(const std::string& name) : Actor(name)
 {
@@ -7,11 +9,32 @@ ARacer::ARacer(const std::string& name) : Actor(name)
 
 void ARacer::update(float deltaTime)
 {
-	// Apply all Steering Behaviors
-	for (const auto& behavior : m_steeringBehaviors) {
-		if (behavior) {
-			behavior->apply(this, deltaTime);
-		}
+	PROFILE_SCOPE("ARacer::steering");
+	if (!m_weightedSteering.empty()) {
+		Transform& transform = *getComponent<Transform>();
+
+		// Batch of one agent; SteeringSystem runs the same code for many racers
+		EngineMath::Vector2 position = transform.getPosition();
+		const uint32_t waypoint = static_cast<uint32_t>(m_currentWaypointIndex);
+		EngineMath::Vector2 force, behaviorForce, levelForce, scratchVector;
+		float budget = 0.f, scratchFloat = 0.f;
+		const float maxForce = getMaxForce();
+
+		SteeringBatch batch;
+		batch.positions = &position;
+		batch.velocities = &m_velocity;
+		batch.maxSpeeds = &m_maxSpeed;
+		batch.maxForces = &maxForce;
+		batch.waypoints = &waypoint;
+		batch.forces = &force;
+		batch.behaviorForces = &behaviorForce;
+		batch.levelForces = &levelForce;
+		batch.budgets = &budget;
+		batch.scratchVectors = &scratchVector;
+		batch.scratchFloats = &scratchFloat;
+		SteeringCombiner::combine(m_weightedSteering, batch, 0, 1);
+		SteeringCombiner::integrate(&position, &m_velocity, &force, &m_maxSpeed, 1, deltaTime);
+		transform.setPosition(position);
 	}
 	Actor::update(deltaTime);
 }
@@ -26,9 +49,17 @@ int ARacer::getPlace() const
 	return m_place;
 }
 
-void ARacer::addSteeringBehavior(EngineUtilities::TSharedPointer<SteeringBehavior> behavior)
+void ARacer::addSteeringBehavior(EngineUtilities::TSharedPointer<SteeringBehavior> behavior, float weight, int priority)
 {
+	if (!behavior) return;
 	m_steeringBehaviors.push_back(behavior);
+
+	WeightedSteering entry;
+	entry.behavior = behavior.get();
+	entry.weight = weight;
+	entry.priority = priority;
+	m_weightedSteering.insert(std::upper_bound(m_weightedSteering.begin(), m_weightedSteering.end(), entry), entry);
+	++m_steeringVersion;
 }
 
 void ARacer::setNextWaypoint(const EngineMath::Vector2& nextWaypoint)
@@ -61,6 +92,16 @@ float ARacer::getMaxSpeed() const
 	return m_maxSpeed;
 }
 
+void ARacer::setMaxForce(float maxForce)
+{
+	m_maxForce = maxForce;
+}
+
+float ARacer::getMaxForce() const
+{
+	return m_maxForce >= 0.f ? m_maxForce : 2.f * m_maxSpeed;
+}
+
 void ARacer::setCurrentWaypointIndex(size_t index)
 {
 	m_currentWaypointIndex = index;
@@ -71,6 +112,16 @@ size_t ARacer::getCurrentWaypointIndex() const
 	return m_currentWaypointIndex;
 }
 
+void ARacer::setPathDistance(float distance)
+{
+	m_pathDistance = distance;
+}
+
+float ARacer::getPathDistance() const
+{
+	return m_pathDistance;
+}
+
 void ARacer::setLapCount(int laps)
 {
 	m_lapCount = laps;
@@ -1,35 +1,50 @@
 #include "ECS/Actor.h"
+#include "ResourceManager.h"
 
 Actor::Actor
 (const std::string& actorName) {
 	m_name = actorName;
 
-	EngineUtilities::TSharedPointer<CShape> shape = EngineUtilities::MakeShared<CShape>();
-	addComponent(shape);
-	 
-	EngineUtilities::TSharedPointer<Transform> transform = EngineUtilities::MakeShared<Transform>();
-	addComponent(transform);
+	emplaceComponent<CShape>();
+	emplaceComponent<Transform>();
 }
 
 void
 Actor::update(float deltaTime) {
-	auto transform = getComponent<Transform>();
-	auto shape = getComponent<CShape>();
+	// Nothing per actor: transforms reach the shapes in syncTransforms
+	(void)deltaTime;
+}
 
-	if(transform && shape) {
-		shape->setPosition(transform->getPosition());
-		shape->setRotation(transform->getRotation());
-		shape->setScale(transform->getScale());
-	}
+void
+Actor::syncTransforms(float alpha) {
+	ThreadPool& threadPool = ThreadPool::getInstance();
+	Registry::getInstance().eachChunk<Transform, CShape>(
+		[&threadPool, alpha](size_t count, const EntityID*, Transform* transforms, CShape* shapes) {
+			// Every row owns its own shape, so the rows can be split across threads
+			threadPool.parallelFor(count, 256, [transforms, shapes, alpha](size_t begin, size_t end) {
+				for (size_t row = begin; row < end; ++row) {
+					shapes[row].setPosition(transforms[row].getInterpolatedPosition(alpha));
+					shapes[row].setRotation(transforms[row].getInterpolatedRotation(alpha));
+					shapes[row].setScale(transforms[row].getInterpolatedScale(alpha));
+				}
+			});
+		});
+}
+
+void
+Actor::storePreviousTransforms() {
+	Registry::getInstance().eachChunk<Transform>([](size_t count, const EntityID*, Transform* transforms) {
+		for (size_t row = 0; row < count; ++row) {
+			transforms[row].storePreviousState();
+		}
+	});
 }
 
 void 
 Actor::render(const EngineUtilities::TSharedPointer<Window>& window) {
-	for(unsigned int i = 0; i < components.size(); ++i) {
-		auto shape = components[i].dynamic_pointer_cast<CShape>();
-		if(shape) {
-			shape->render(window);
-		}
+	auto shape = getComponent<CShape>();
+	if(shape) {
+		shape->render(window);
 	}
 }
 
@@ -43,3 +58,19 @@ Actor::setTexture(const EngineUtilities::TSharedPointer<Texture>& texture) {
 		}
 	}
 }
+
+void
+Actor::setTexture(TextureHandle handle) {
+	setTexture(TextureRegion{ ResourceManager::getInstance().getTexture(handle), sf::IntRect(), handle });
+}
+
+void
+Actor::setTexture(const TextureRegion& region) {
+	auto shape = getComponent<CShape>();
+	if (shape) {
+		if (!region.texture.isNull()) {
+			shape->setTexture(region);
+			addComponent(region.texture);
+		}
+	}
+}
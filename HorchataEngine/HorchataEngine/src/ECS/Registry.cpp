@@ -0,0 +1,133 @@
+#include "ECS/Registry.h"
+
+Registry::Registry() {
+	// Archetype 0 is the empty signature every new entity starts in
+	m_archetypes.push_back(EngineUtilities::MakeUnique<Archetype>());
+	m_archetypeLookup[0] = 0;
+}
+
+EntityID
+Registry::create() {
+	EntityID entity;
+	if (!m_freeIds.empty()) {
+		entity = m_freeIds.back();
+		m_freeIds.pop_back();
+	}
+	else {
+		entity = static_cast<EntityID>(m_records.size());
+		m_records.emplace_back();
+	}
+
+	Archetype& empty = *m_archetypes[0];
+	empty.entities.push_back(entity);
+
+	EntityRecord& record = m_records[entity];
+	record.archetype = 0;
+	record.row = static_cast<uint32_t>(empty.entities.size() - 1);
+	record.alive = true;
+	return entity;
+}
+
+void
+Registry::destroy(EntityID entity) {
+	if (!isAlive(entity)) {
+		return;
+	}
+
+	EntityRecord& record = m_records[entity];
+	removeRow(*m_archetypes[record.archetype], record.row);
+	record.alive = false;
+	m_freeIds.push_back(entity);
+}
+
+uint32_t
+Registry::findArchetype(ComponentMask mask) const {
+	auto it = m_archetypeLookup.find(mask);
+	return it != m_archetypeLookup.end() ? it->second : INVALID_INDEX;
+}
+
+uint32_t
+Registry::createArchetype(ComponentMask mask,
+                          const Archetype& source,
+                          EngineUtilities::TUniquePtr<IComponentColumn> extraColumn,
+                          ComponentTypeID extraTypeID) {
+	auto archetype = EngineUtilities::MakeUnique<Archetype>();
+	archetype->mask = mask;
+
+	for (ComponentTypeID type = 0; type < MAX_COMPONENT_TYPES; ++type) {
+		if (!(mask & (ComponentMask(1) << type))) {
+			continue;
+		}
+		if (type == extraTypeID) {
+			archetype->columns[type] = std::move(extraColumn);
+		}
+		else if (!source.columns[type].isNull()) {
+			archetype->columns[type] = source.columns[type]->createEmpty();
+		}
+	}
+
+	const uint32_t index = static_cast<uint32_t>(m_archetypes.size());
+	m_archetypes.push_back(std::move(archetype));
+	m_archetypeLookup[mask] = index;
+	return index;
+}
+
+void
+Registry::moveEntity(EntityID entity, uint32_t target) {
+	EntityRecord& record = m_records[entity];
+	Archetype& source = *m_archetypes[record.archetype];
+	Archetype& destination = *m_archetypes[target];
+
+	for (ComponentTypeID type = 0; type < MAX_COMPONENT_TYPES; ++type) {
+		if (!source.columns[type].isNull() && !destination.columns[type].isNull()) {
+			source.columns[type]->moveElementTo(record.row, *destination.columns[type]);
+		}
+	}
+	destination.entities.push_back(entity);
+
+	removeRow(source, record.row);
+	record.archetype = target;
+	record.row = static_cast<uint32_t>(destination.entities.size() - 1);
+}
+
+void
+Registry::reportMemoryUsage() const {
+	int64_t counts[MAX_COMPONENT_TYPES] = {};
+	int64_t bytes[MAX_COMPONENT_TYPES] = {};
+	const IComponentColumn* columns[MAX_COMPONENT_TYPES] = {};
+
+	// A type has one column per archetype that contains it
+	for (const auto& archetype : m_archetypes) {
+		for (ComponentTypeID type = 0; type < MAX_COMPONENT_TYPES; ++type) {
+			const IComponentColumn* column = archetype->columns[type].get();
+			if (column) {
+				counts[type] += static_cast<int64_t>(column->size());
+				bytes[type] += static_cast<int64_t>(column->capacityBytes());
+				columns[type] = column;
+			}
+		}
+	}
+
+	EngineUtilities::MemoryTracker& tracker = EngineUtilities::MemoryTracker::getInstance();
+	for (ComponentTypeID type = 0; type < MAX_COMPONENT_TYPES; ++type) {
+		if (columns[type]) {
+			tracker.setUsage(columns[type]->memorySlot(), counts[type], bytes[type]);
+		}
+	}
+}
+
+void
+Registry::removeRow(Archetype& archetype, uint32_t row) {
+	for (ComponentTypeID type = 0; type < MAX_COMPONENT_TYPES; ++type) {
+		if (!archetype.columns[type].isNull()) {
+			archetype.columns[type]->removeRow(row);
+		}
+	}
+
+	const EntityID last = archetype.entities.back();
+	archetype.entities[row] = last;
+	archetype.entities.pop_back();
+	if (row < archetype.entities.size()) {
+		m_records[last].row = row;
+	}
+}
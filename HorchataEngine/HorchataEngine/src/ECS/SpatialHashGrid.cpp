@@ -0,0 +1,78 @@
+#include "ECS/SpatialHashGrid.h"
+
+SpatialHashGrid::SpatialHashGrid(float cellSize)
+	: m_cellSize(cellSize > 0.0f ? cellSize : 1.0f),
+	  m_inverseCellSize(1.0f / m_cellSize) {
+}
+
+void
+SpatialHashGrid::clear() {
+	m_pending.clear();
+	m_entries.clear();
+	m_cellStart.clear();
+	m_maxRadius = 0.0f;
+}
+
+void
+SpatialHashGrid::insert(EntityID id, const EngineMath::Vector2& position, float radius) {
+	Entry entry;
+	entry.id = id;
+	entry.position = position;
+	entry.radius = radius;
+	entry.cellX = cellCoordinate(position.x);
+	entry.cellY = cellCoordinate(position.y);
+	m_pending.push_back(entry);
+	m_maxRadius = radius > m_maxRadius ? radius : m_maxRadius;
+}
+
+void
+SpatialHashGrid::build() {
+	// Twice as many buckets as entries (power of two) keeps shared buckets rare
+	uint32_t bucketCount = 16;
+	while (bucketCount < m_pending.size() * 2) {
+		bucketCount <<= 1;
+	}
+	m_bucketMask = bucketCount - 1;
+
+	// Counting sort by bucket: count, prefix sum, scatter
+	m_cellStart.assign(bucketCount + 1, 0);
+	for (const Entry& entry : m_pending) {
+		++m_cellStart[bucketIndex(entry.cellX, entry.cellY) + 1];
+	}
+	for (uint32_t bucket = 0; bucket < bucketCount; ++bucket) {
+		m_cellStart[bucket + 1] += m_cellStart[bucket];
+	}
+
+	m_entries.resize(m_pending.size());
+	for (const Entry& entry : m_pending) {
+		// m_cellStart[bucket] is used as the write cursor and ends at the next bucket start
+		m_entries[m_cellStart[bucketIndex(entry.cellX, entry.cellY)]++] = entry;
+	}
+	for (uint32_t bucket = bucketCount; bucket > 0; --bucket) {
+		m_cellStart[bucket] = m_cellStart[bucket - 1];
+	}
+	m_cellStart[0] = 0;
+	m_pending.clear();
+}
+
+size_t
+SpatialHashGrid::queryRadius(const EngineMath::Vector2& center,
+                             float radius,
+                             std::vector<EntityID>& results) const {
+	results.clear();
+	queryRadius(center, radius, [&results](const Entry& entry) {
+		results.push_back(entry.id);
+	});
+	return results.size();
+}
+
+size_t
+SpatialHashGrid::queryAABB(const EngineMath::Vector2& min,
+                           const EngineMath::Vector2& max,
+                           std::vector<EntityID>& results) const {
+	results.clear();
+	queryAABB(min, max, [&results](const Entry& entry) {
+		results.push_back(entry.id);
+	});
+	return results.size();
+}
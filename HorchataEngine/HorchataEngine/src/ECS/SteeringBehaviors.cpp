@@ -1,57 +1,144 @@
 #include "SteeringBehaviors.h"
-#include "ECS/Actor.h"
-#include "ECS/Transform.h"
-#include "ECS/ARacer.h"
+#include "ECS/SpatialHashGrid.h"
+#include <algorithm>
 
-// Implementation of PathFollowing
-PathFollowing::PathFollowing(const std::vector<EngineMath::Vector2>& waypoints)
-	: m_waypoints(waypoints)
-{
-}
+namespace {
+	/**
+	 * @brief Force that steers every agent of [begin, end) to the target in scratchVectors.
+	 * Full speed outside slowingRadius, proportionally slower inside it ("Arrive").
+	 */
+	void
+	seekForces(const SteeringBatch& batch, size_t begin, size_t end, float slowingRadius, EngineMath::Vector2* forces)
+	{
+		const size_t count = end - begin;
+		const EngineMath::Vector2* positions = batch.positions + begin;
+		const EngineMath::Vector2* velocities = batch.velocities + begin;
+		EngineMath::Vector2* offsets = batch.scratchVectors + begin;
+		float* distances = batch.scratchFloats + begin;
+		const float* maxSpeeds = batch.maxSpeeds + begin;
+		forces += begin;
 
-void PathFollowing::apply(Actor* actor, float deltaTime)
-{
-	ARacer* racer = dynamic_cast<ARacer*>(actor);
-	if (!racer) return;
+		for (size_t i = 0; i < count; ++i) {
+			offsets[i] -= positions[i];
+		}
+		EngineMath::vectorLengths(offsets, count, distances);
 
-	EngineUtilities::TSharedPointer<Transform> transform = racer->getComponent<Transform>();
-	if (!transform) return;
+		// Desired velocity minus current velocity
+		const float invSlowingRadius = 1.f / slowingRadius;
+		for (size_t i = 0; i < count; ++i) {
+			const float distance = distances[i];
+			const float speed = maxSpeeds[i] * std::min(distance * invSlowingRadius, 1.f);
+			const float scale = distance > 0.f ? speed / distance : 0.f;
+			forces[i] = offsets[i] * scale - velocities[i];
+		}
+	}
 
-	EngineMath::Vector2 currentPos = transform->getPosition();
-	size_t currentWaypointIndex = racer->getCurrentWaypointIndex();
+	/**
+	 * @brief Calls func(index) for every other agent of the batch within radius of agent i.
+	 * Grid queries only visit the cells around the agent, so a pass stays linear
+	 * in the number of agents as long as the density does not grow.
+	 */
+	template<typename Func>
+	void
+	forEachNeighbor(const SteeringBatch& batch, size_t i, float radius, Func&& func)
+	{
+		batch.neighbors->queryRadius(batch.positions[i], radius, [i, &func](const SpatialHashGrid::Entry& entry) {
+			if (entry.id != i) {
+				func(static_cast<size_t>(entry.id));
+			}
+		});
+	}
 
-	// If we are close to the current waypoint, advance to the next one
-	EngineMath::Vector2 targetPos = m_waypoints[currentWaypointIndex];
-	float distanceToWaypoint = EngineMath::Vector2::distance(currentPos, targetPos);
-	if (distanceToWaypoint < 50.f) { // Threshold of 50.f to detect arrival at the waypoint
-		currentWaypointIndex = (currentWaypointIndex + 1) % m_waypoints.size();
-		racer->setCurrentWaypointIndex(currentWaypointIndex);
-		targetPos = m_waypoints[currentWaypointIndex];
+	/**
+	 * @brief Writes a zero force for [begin, end). Used when a behavior has nothing to react to.
+	 */
+	void
+	clearForces(size_t begin, size_t end, EngineMath::Vector2* forces)
+	{
+		for (size_t i = begin; i < end; ++i) {
+			forces[i] = EngineMath::Vector2(0.f, 0.f);
+		}
 	}
+}
 
-	// More detailed "Seek" behavior to follow the path
-	EngineMath::Vector2 desiredVelocity = targetPos - currentPos;
-	float length = desiredVelocity.length();
+void
+SteeringCombiner::combine(const std::vector<WeightedSteering>& behaviors, const SteeringBatch& batch, size_t begin, size_t end)
+{
+	const size_t count = end - begin;
+	EngineMath::Vector2* forces = batch.forces + begin;
+	EngineMath::Vector2* behaviorForces = batch.behaviorForces + begin;
+	EngineMath::Vector2* levelForces = batch.levelForces + begin;
+	float* budgets = batch.budgets + begin;
+	float* lengths = batch.scratchFloats + begin;
 
-	// If the bot is close to the target, reduce speed ("Arrive" behavior)
-	if (length < 200.0f) {
-		desiredVelocity = desiredVelocity.normalized() * (racer->getMaxSpeed() * (length / 200.0f));
-	}
-	else {
-		desiredVelocity = desiredVelocity.normalized() * racer->getMaxSpeed();
+	for (size_t i = 0; i < count; ++i) {
+		forces[i] = EngineMath::Vector2(0.f, 0.f);
+		budgets[i] = batch.maxForces[begin + i];
 	}
 
-	EngineMath::Vector2 steering = desiredVelocity - racer->getVelocity();
-	EngineMath::Vector2 newVelocity = racer->getVelocity() + steering * deltaTime;
+	size_t next = 0;
+	while (next < behaviors.size()) {
+		// Weighted sum of one priority level
+		const int priority = behaviors[next].priority;
+		for (size_t i = 0; i < count; ++i) {
+			levelForces[i] = EngineMath::Vector2(0.f, 0.f);
+		}
+		for (; next < behaviors.size() && behaviors[next].priority == priority; ++next) {
+			const float weight = behaviors[next].weight;
+			behaviors[next].behavior->computeForces(batch, begin, end, batch.behaviorForces);
+			for (size_t i = 0; i < count; ++i) {
+				levelForces[i] += behaviorForces[i] * weight;
+			}
+		}
+
+		// The level gets what the higher levels left of the budget
+		EngineMath::vectorLengths(levelForces, count, lengths);
+		for (size_t i = 0; i < count; ++i) {
+			const float taken = std::min(lengths[i], budgets[i]);
+			const float scale = lengths[i] > 0.f ? taken / lengths[i] : 0.f;
+			forces[i] += levelForces[i] * scale;
+			budgets[i] -= taken;
+		}
+	}
+}
 
-	// Limit maximum speed
-	if (newVelocity.length() > racer->getMaxSpeed()) {
-		newVelocity = newVelocity.normalized() * racer->getMaxSpeed();
+void
+SteeringCombiner::integrate(EngineMath::Vector2* positions,
+                            EngineMath::Vector2* velocities,
+                            const EngineMath::Vector2* forces,
+                            const float* maxSpeeds,
+                            size_t count,
+                            float deltaTime)
+{
+	for (size_t i = 0; i < count; ++i) {
+		velocities[i] += forces[i] * deltaTime;
 	}
-	racer->setVelocity(newVelocity);
+	EngineMath::clampLengths(velocities, maxSpeeds, count);
+	EngineMath::integratePositions(positions, velocities, count, deltaTime);
+}
 
-	// Apply velocity to the transform
-	transform->setPosition(currentPos + newVelocity * deltaTime);
+// Implementation of PathFollowing
+PathFollowing::PathFollowing(const EngineUtilities::TSharedPointer<Path>& path)
+	: m_path(path)
+{
+}
+
+void PathFollowing::computeForces(const SteeringBatch& batch, size_t begin, size_t end, EngineMath::Vector2* forces) const
+{
+	const Path& path = *m_path;
+	const size_t pointCount = path.getPointCount();
+	const float arrivalRadiusSq = m_arrivalRadius * m_arrivalRadius;
+
+	// The waypoint comes from the race progress (GameManager); once close to it,
+	// aim at the one after so the kart turns before reaching the corner
+	for (size_t i = begin; i < end; ++i) {
+		const uint32_t waypoint = batch.waypoints[i];
+		const EngineMath::Vector2& target = path.getPoint(waypoint);
+		batch.scratchVectors[i] = (target - batch.positions[i]).lengthSq() < arrivalRadiusSq
+			? path.getPoint((waypoint + 1) % pointCount)
+			: target;
+	}
+	seekForces(batch, begin, end, m_slowingRadius, forces);
 }
 
 // Implementation of Arrive methods
@@ -61,48 +148,139 @@ Arrive::Arrive(const EngineMath::Vector2& target)
 	// The slowing radius is initialized in the header
 }
 
-void Arrive::apply(Actor* actor, float deltaTime)
+void Arrive::computeForces(const SteeringBatch& batch, size_t begin, size_t end, EngineMath::Vector2* forces) const
 {
-	ARacer* racer = dynamic_cast<ARacer*>(actor);
-	if (!racer) return;
+	for (size_t i = begin; i < end; ++i) {
+		batch.scratchVectors[i] = m_target;
+	}
+	seekForces(batch, begin, end, m_slowingRadius, forces);
+}
 
-	EngineUtilities::TSharedPointer<Transform> transform = racer->getComponent<Transform>();
-	if (!transform) return;
+// Implementation of Separation
+Separation::Separation(float radius)
+	: m_radius(radius)
+{
+}
 
-	EngineMath::Vector2 currentPos = transform->getPosition();
-	EngineMath::Vector2 desiredVelocity = m_target - currentPos;
-	float distance = desiredVelocity.length();
+void Separation::computeForces(const SteeringBatch& batch, size_t begin, size_t end, EngineMath::Vector2* forces) const
+{
+	if (!batch.neighbors) {
+		clearForces(begin, end, forces);
+		return;
+	}
 
-	if (distance > 0)
-	{
-		// If the distance is less than the slowing radius, Arrive
-		if (distance < m_slowingRadius)
-		{
-			float desiredSpeed = racer->getMaxSpeed() * (distance / m_slowingRadius);
-			desiredVelocity = desiredVelocity.normalized() * desiredSpeed;
-		}
-		else // Otherwise, act as Seek (maximum speed)
-		{
-			desiredVelocity = desiredVelocity.normalized() * racer->getMaxSpeed();
-		}
+	const float invRadius = 1.f / m_radius;
+	for (size_t i = begin; i < end; ++i) {
+		// Unit push from each neighbour, fading to zero at the radius
+		const EngineMath::Vector2 position = batch.positions[i];
+		EngineMath::Vector2 push(0.f, 0.f);
+		forEachNeighbor(batch, i, m_radius, [&](size_t other) {
+			const EngineMath::Vector2 away = position - batch.positions[other];
+			const float distance = away.length();
+			if (distance > 0.f) {
+				push += away * ((1.f - distance * invRadius) / distance);
+			}
+		});
+		forces[i] = push * batch.maxForces[i];
+	}
+}
 
-		// Calculate steering force
-		EngineMath::Vector2 steering = desiredVelocity - racer->getVelocity();
-		EngineMath::Vector2 newVelocity = racer->getVelocity() + steering * deltaTime;
+// Implementation of Alignment
+Alignment::Alignment(float radius)
+	: m_radius(radius)
+{
+}
 
-		// Limit maximum speed
-		if (newVelocity.length() > racer->getMaxSpeed())
-		{
-			newVelocity = newVelocity.normalized() * racer->getMaxSpeed();
+void Alignment::computeForces(const SteeringBatch& batch, size_t begin, size_t end, EngineMath::Vector2* forces) const
+{
+	if (!batch.neighbors) {
+		clearForces(begin, end, forces);
+		return;
+	}
+
+	for (size_t i = begin; i < end; ++i) {
+		EngineMath::Vector2 sum(0.f, 0.f);
+		size_t count = 0;
+		forEachNeighbor(batch, i, m_radius, [&](size_t other) {
+			sum += batch.velocities[other];
+			++count;
+		});
+		forces[i] = count > 0
+			? sum / static_cast<float>(count) - batch.velocities[i]
+			: EngineMath::Vector2(0.f, 0.f);
+	}
+}
+
+// Implementation of Cohesion
+Cohesion::Cohesion(float radius)
+	: m_radius(radius)
+{
+}
+
+void Cohesion::computeForces(const SteeringBatch& batch, size_t begin, size_t end, EngineMath::Vector2* forces) const
+{
+	if (!batch.neighbors) {
+		clearForces(begin, end, forces);
+		return;
+	}
+
+	for (size_t i = begin; i < end; ++i) {
+		EngineMath::Vector2 sum(0.f, 0.f);
+		size_t count = 0;
+		forEachNeighbor(batch, i, m_radius, [&](size_t other) {
+			sum += batch.positions[other];
+			++count;
+		});
+		if (count == 0) {
+			forces[i] = EngineMath::Vector2(0.f, 0.f);
+			continue;
 		}
-		racer->setVelocity(newVelocity);
+		const EngineMath::Vector2 toCenter = sum / static_cast<float>(count) - batch.positions[i];
+		forces[i] = toCenter.normalized() * batch.maxSpeeds[i] - batch.velocities[i];
+	}
+}
+
+// Implementation of WallAvoidance
+WallAvoidance::WallAvoidance(const EngineUtilities::TSharedPointer<TrackCollisionMask>& mask,
+                             float lookAhead,
+                             float avoidDistance)
+	: m_mask(mask), m_lookAhead(lookAhead), m_avoidDistance(avoidDistance)
+{
+}
 
-		// Apply velocity to the transform
-		transform->setPosition(currentPos + newVelocity * deltaTime);
+void WallAvoidance::computeForces(const SteeringBatch& batch, size_t begin, size_t end, EngineMath::Vector2* forces) const
+{
+	// Without a distance field there is no way to tell how far the edge is
+	if (!m_mask || !m_mask->hasDistanceField()) {
+		clearForces(begin, end, forces);
+		return;
 	}
-	else
-	{
-		// Stop the racer if it is already at the target
-		racer->setVelocity({ 0, 0 });
+
+	const TrackCollisionMask& mask = *m_mask;
+	const EngineMath::Vector2 stepX(m_sampleStep, 0.f);
+	const EngineMath::Vector2 stepY(0.f, m_sampleStep);
+	const float invAvoidDistance = 1.f / m_avoidDistance;
+	for (size_t i = begin; i < end; ++i) {
+		// Outside the track rectangle the field says nothing, so there is nothing to avoid
+		const EngineMath::Vector2 probe = batch.positions[i] + batch.velocities[i] * m_lookAhead;
+		if (!mask.contains(probe)) {
+			forces[i] = EngineMath::Vector2(0.f, 0.f);
+			continue;
+		}
+		const float distance = mask.signedDistance(probe);
+		if (distance >= m_avoidDistance) {
+			forces[i] = EngineMath::Vector2(0.f, 0.f);
+			continue;
+		}
+
+		// The field grows towards the road. Samples across the rectangle border
+		// reuse the probe's distance, which makes that side a one-sided difference
+		auto sample = [&mask, distance](const EngineMath::Vector2& position) {
+			return mask.contains(position) ? mask.signedDistance(position) : distance;
+		};
+		const EngineMath::Vector2 gradient(sample(probe + stepX) - sample(probe - stepX),
+		                                   sample(probe + stepY) - sample(probe - stepY));
+		const float urgency = std::min((m_avoidDistance - distance) * invAvoidDistance, 1.f);
+		forces[i] = gradient.normalized() * (batch.maxForces[i] * urgency);
 	}
-}
\ No newline at end of file
+}
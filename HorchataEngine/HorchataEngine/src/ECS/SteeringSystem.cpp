@@ -0,0 +1,181 @@
+#include "ECS/SteeringSystem.h"
+#include "ECS/Transform.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <map>
+
+bool
+SteeringSystem::needsRebuild(const std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers) const {
+	if (racers.size() != m_racers.size()) {
+		return true;
+	}
+	for (size_t i = 0; i < racers.size(); ++i) {
+		if (racers[i].get() != m_racers[i] || racers[i]->getSteeringVersion() != m_steeringVersions[i]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void
+SteeringSystem::rebuild(const std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers) {
+	m_groups.clear();
+	m_neighborRadius = 0.f;
+	m_racers.resize(racers.size());
+	m_steeringVersions.resize(racers.size());
+
+	// Group index of every racer, groups in order of first appearance
+	std::map<std::vector<WeightedSteering>, size_t> groupOfSet;
+	std::vector<size_t> groupOfRacer(racers.size());
+	std::vector<size_t> groupSizes;
+	for (size_t i = 0; i < racers.size(); ++i) {
+		m_racers[i] = racers[i].get();
+		m_steeringVersions[i] = racers[i]->getSteeringVersion();
+
+		const std::vector<WeightedSteering>& behaviors = racers[i]->getSteeringBehaviors();
+		auto it = groupOfSet.find(behaviors);
+		if (it == groupOfSet.end()) {
+			it = groupOfSet.emplace(behaviors, m_groups.size()).first;
+			Group group;
+			group.behaviors = behaviors;
+			m_groups.push_back(group);
+			for (const WeightedSteering& steering : behaviors) {
+				m_neighborRadius = std::max(m_neighborRadius, steering.behavior->getNeighborRadius());
+			}
+			groupSizes.push_back(0);
+		}
+		groupOfRacer[i] = it->second;
+		++groupSizes[it->second];
+	}
+
+	// Counting sort: every group takes a contiguous range of slots
+	size_t slot = 0;
+	for (size_t g = 0; g < m_groups.size(); ++g) {
+		m_groups[g].begin = slot;
+		m_groups[g].end = slot;
+		slot += groupSizes[g];
+	}
+	m_racerOfSlot.resize(racers.size());
+	for (size_t i = 0; i < racers.size(); ++i) {
+		m_racerOfSlot[m_groups[groupOfRacer[i]].end++] = static_cast<uint32_t>(i);
+	}
+
+	m_positions.resize(racers.size());
+	m_velocities.resize(racers.size());
+	m_maxSpeeds.resize(racers.size());
+	m_maxForces.resize(racers.size());
+	m_forces.resize(racers.size());
+	m_behaviorForces.resize(racers.size());
+	m_levelForces.resize(racers.size());
+	m_budgets.resize(racers.size());
+	m_waypoints.resize(racers.size());
+	m_scratchVectors.resize(racers.size());
+	m_scratchFloats.resize(racers.size());
+
+	// A cell about the size of a query keeps each query to a few cells
+	if (m_neighborRadius > 0.f && m_neighborGrid.getCellSize() != m_neighborRadius * 2.f) {
+		m_neighborGrid = SpatialHashGrid(m_neighborRadius * 2.f);
+	}
+}
+
+void
+SteeringSystem::update(const std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers,
+                       float deltaTime,
+                       const std::vector<NeighborKart>& neighborKarts) {
+	PROFILE_SCOPE("SteeringSystem::update");
+	if (needsRebuild(racers)) {
+		rebuild(racers);
+	}
+
+	// Neighbour karts only need a position and a velocity, no steering slot
+	const size_t racerCount = m_racerOfSlot.size();
+	if (m_neighborRadius > 0.f) {
+		m_positions.resize(racerCount + neighborKarts.size());
+		m_velocities.resize(racerCount + neighborKarts.size());
+		for (size_t i = 0; i < neighborKarts.size(); ++i) {
+			m_positions[racerCount + i] = neighborKarts[i].position;
+			m_velocities[racerCount + i] = neighborKarts[i].velocity;
+		}
+	}
+
+	ThreadPool& threadPool = ThreadPool::getInstance();
+	threadPool.parallelFor(racerCount, GRAIN_SIZE, [this, &racers](size_t begin, size_t end) {
+		gatherRange(racers, begin, end);
+	});
+
+	SteeringBatch batch = makeBatch();
+	if (m_neighborRadius > 0.f) {
+		m_neighborGrid.clear();
+		for (size_t slot = 0; slot < m_positions.size(); ++slot) {
+			m_neighborGrid.insert(static_cast<EntityID>(slot), m_positions[slot]);
+		}
+		m_neighborGrid.build();
+		batch.neighbors = &m_neighborGrid;
+	}
+
+	// Every force is computed before any racer moves
+	for (const Group& group : m_groups) {
+		// Racers without behaviors are not moved by steering
+		if (group.behaviors.empty()) {
+			continue;
+		}
+		threadPool.parallelFor(group.end - group.begin, GRAIN_SIZE,
+			[&group, &batch](size_t begin, size_t end) {
+				SteeringCombiner::combine(group.behaviors, batch, group.begin + begin, group.begin + end);
+			});
+	}
+	for (const Group& group : m_groups) {
+		if (group.behaviors.empty()) {
+			continue;
+		}
+		threadPool.parallelFor(group.end - group.begin, GRAIN_SIZE,
+			[this, &racers, &group, deltaTime](size_t begin, size_t end) {
+				integrateRange(racers, group.begin + begin, group.begin + end, deltaTime);
+			});
+	}
+}
+
+void
+SteeringSystem::gatherRange(const std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers, size_t begin, size_t end) {
+	for (size_t slot = begin; slot < end; ++slot) {
+		ARacer& racer = *racers[m_racerOfSlot[slot]];
+		m_positions[slot] = racer.getComponent<Transform>()->getPosition();
+		m_velocities[slot] = racer.getVelocity();
+		m_maxSpeeds[slot] = racer.getMaxSpeed();
+		m_maxForces[slot] = racer.getMaxForce();
+		m_waypoints[slot] = static_cast<uint32_t>(racer.getCurrentWaypointIndex());
+	}
+}
+
+SteeringBatch
+SteeringSystem::makeBatch() {
+	SteeringBatch batch;
+	batch.positions = m_positions.data();
+	batch.velocities = m_velocities.data();
+	batch.maxSpeeds = m_maxSpeeds.data();
+	batch.maxForces = m_maxForces.data();
+	batch.waypoints = m_waypoints.data();
+	batch.forces = m_forces.data();
+	batch.behaviorForces = m_behaviorForces.data();
+	batch.levelForces = m_levelForces.data();
+	batch.budgets = m_budgets.data();
+	batch.scratchVectors = m_scratchVectors.data();
+	batch.scratchFloats = m_scratchFloats.data();
+	return batch;
+}
+
+void
+SteeringSystem::integrateRange(const std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers,
+                               size_t begin,
+                               size_t end,
+                               float deltaTime) {
+	SteeringCombiner::integrate(m_positions.data() + begin, m_velocities.data() + begin, m_forces.data() + begin,
+	                            m_maxSpeeds.data() + begin, end - begin, deltaTime);
+
+	// Transforms live in Registry columns, so they are looked up again rather than kept between passes
+	for (size_t slot = begin; slot < end; ++slot) {
+		ARacer& racer = *racers[m_racerOfSlot[slot]];
+		racer.setVelocity(m_velocities[slot]);
+		racer.getComponent<Transform>()->setPosition(m_positions[slot]);
+	}
+}
@@ -0,0 +1,64 @@
+#include "ECS/SystemScheduler.h"
+#include "Profiler.h"
+
+void
+SystemScheduler::addSystem(const std::string& name,
+                           ResourceMask reads,
+                           ResourceMask writes,
+                           SystemFunction function,
+                           bool mainThreadOnly) {
+	System system;
+	system.name = name;
+	system.zoneName = Profiler::getInstance().internName(name);
+	system.reads = reads;
+	system.writes = writes;
+	system.function = std::move(function);
+	system.mainThreadOnly = mainThreadOnly;
+
+	// Run after the last system registered before this one that touches the same data
+	size_t stage = 0;
+	for (size_t i = 0; i < m_systems.size(); ++i) {
+		if (conflicts(system, m_systems[i]) && m_systemStages[i] + 1 > stage) {
+			stage = m_systemStages[i] + 1;
+		}
+	}
+
+	if (stage == m_stages.size()) {
+		m_stages.emplace_back();
+	}
+	m_stages[stage].push_back(m_systems.size());
+	m_systemStages.push_back(stage);
+	m_systems.push_back(std::move(system));
+}
+
+void
+SystemScheduler::run(float deltaTime) {
+	PROFILE_SCOPE("SystemScheduler::run");
+	for (const auto& stage : m_stages) {
+		if (stage.size() == 1) {
+			runSystem(m_systems[stage.front()], deltaTime);
+			continue;
+		}
+
+		JobCounter remaining{ 0 };
+		for (size_t index : stage) {
+			System& system = m_systems[index];
+			if (!system.mainThreadOnly) {
+				remaining.fetch_add(1, std::memory_order_relaxed);
+				m_threadPool.submit([&system, deltaTime]() { runSystem(system, deltaTime); }, &remaining);
+			}
+		}
+		for (size_t index : stage) {
+			if (m_systems[index].mainThreadOnly) {
+				runSystem(m_systems[index], deltaTime);
+			}
+		}
+		m_threadPool.wait(remaining);
+	}
+}
+
+void
+SystemScheduler::runSystem(System& system, float deltaTime) {
+	PROFILE_SCOPE(system.zoneName);
+	system.function(deltaTime);
+}
@@ -1,6 +1,56 @@
 #include "EngineGUI.h"
 #include "Window.h"
 #include "ECS/Actor.h"
+#include "SpriteBatch.h"
+#include "Profiler.h"
+#include <algorithm>
+
+namespace {
+	/**
+	 * @brief Draws a zone and its children as tree nodes.
+	 * @param zones Zones of one thread, sorted by start time.
+	 * @param index Zone to draw.
+	 * @param end End of the range its children may be in.
+	 * @param frameTime Duration of the frame in nanoseconds, for the percentages.
+	 * @return Index of the first zone after its children.
+	 */
+	size_t
+	zoneTree(const std::vector<ProfileZone>& zones, size_t index, size_t end, double frameTime) {
+		const ProfileZone& zone = zones[index];
+		size_t next = index + 1;
+		while (next < end && zones[next].depth > zone.depth) {
+			++next;
+		}
+
+		const double duration = static_cast<double>(zone.end - zone.start);
+		ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_DefaultOpen;
+		if (next == index + 1) {
+			flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+		}
+
+		bool nodeOpen = ImGui::TreeNodeEx((void*)(intptr_t)index, flags, "%s  %.3f ms (%.1f%%)",
+			zone.name, duration / 1.0e6, 100.0 * duration / frameTime);
+		if (nodeOpen && next != index + 1) {
+			for (size_t child = index + 1; child < next;) {
+				child = zoneTree(zones, child, next, frameTime);
+			}
+			ImGui::TreePop();
+		}
+		return next;
+	}
+
+	/**
+	 * @brief Picks a stable color for a zone name.
+	 */
+	ImU32
+	zoneColor(const char* name) {
+		uint32_t hash = 2166136261u;
+		for (const char* c = name; *c; ++c) {
+			hash = (hash ^ static_cast<unsigned char>(*c)) * 16777619u;
+		}
+		return ImColor::HSV((hash % 360) / 360.0f, 0.55f, 0.75f);
+	}
+}
 
 void
 EngineGUI::init(const EngineUtilities::TSharedPointer<Window>& window) {
@@ -455,6 +505,181 @@ void EngineGUI::inspector(const std::vector<EngineUtilities::TSharedPointer<Acto
 	ImGui::End();
 }
 
+void
+EngineGUI::profiler(const RenderStats& renderStats) {
+	Profiler& profiler = Profiler::getInstance();
+	ImGui::Begin("Profiler");
+
+	bool recording = profiler.isEnabled();
+	if (ImGui::Checkbox("Record", &recording)) {
+		profiler.setEnabled(recording);
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Export trace")) {
+		profilerStatus = profiler.exportChromeTrace("profile.json") ? "Saved profile.json" : "Can't write profile.json";
+	}
+	if (!profilerStatus.empty()) {
+		ImGui::SameLine();
+		ImGui::TextUnformatted(profilerStatus.c_str());
+	}
+
+	// Frame time history
+	const std::vector<float>& history = profiler.getFrameHistory();
+	float average = 0.0f;
+	float maximum = 0.0f;
+	for (float frameTime : history) {
+		average += frameTime;
+		maximum = frameTime > maximum ? frameTime : maximum;
+	}
+	average /= static_cast<float>(history.size());
+
+	char overlay[64];
+	snprintf(overlay, sizeof(overlay), "avg %.2f ms  max %.2f ms", average, maximum);
+	ImGui::PlotLines("##FrameTimes", history.data(), static_cast<int>(history.size()),
+		static_cast<int>(profiler.getFrameHistoryOffset()), overlay,
+		0.0f, maximum > 33.3f ? maximum : 33.3f, ImVec2(ImGui::GetContentRegionAvail().x, 80.0f));
+
+	ImGui::Text("Draw calls: %zu  Vertices: %zu  Sprites: %zu",
+		renderStats.drawCalls, renderStats.vertices, renderStats.sprites);
+	ImGui::Separator();
+
+	const std::vector<ProfileZone>& zones = profiler.getFrameZones();
+	const uint64_t frameStart = profiler.getFrameStart();
+	const double frameTime = profiler.getFrameEnd() > frameStart
+		? static_cast<double>(profiler.getFrameEnd() - frameStart) : 1.0;
+
+	// Flame view: one band per thread, one row per depth, x is time inside the frame
+	if (ImGui::CollapsingHeader("Timeline", ImGuiTreeNodeFlags_DefaultOpen)) {
+		const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+		const float width = ImGui::GetContentRegionAvail().x;
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+		for (size_t begin = 0; begin < zones.size();) {
+			size_t end = begin;
+			uint32_t depthCount = 0;
+			while (end < zones.size() && zones[end].threadId == zones[begin].threadId) {
+				depthCount = zones[end].depth + 1 > depthCount ? zones[end].depth + 1 : depthCount;
+				++end;
+			}
+
+			ImGui::TextUnformatted(profiler.getThreadName(zones[begin].threadId).c_str());
+			const ImVec2 origin = ImGui::GetCursorScreenPos();
+			ImGui::Dummy(ImVec2(width, rowHeight * depthCount));
+
+			for (size_t i = begin; i < end; ++i) {
+				const ProfileZone& zone = zones[i];
+				const double startTime = zone.start > frameStart ? static_cast<double>(zone.start - frameStart) : 0.0;
+				const double endTime = zone.end > frameStart ? static_cast<double>(zone.end - frameStart) : 0.0;
+				float x0 = origin.x + static_cast<float>(std::min(startTime / frameTime, 1.0)) * width;
+				float x1 = origin.x + static_cast<float>(std::min(endTime / frameTime, 1.0)) * width;
+				x1 = x1 - x0 < 1.0f ? x0 + 1.0f : x1;
+				const ImVec2 minCorner(x0, origin.y + zone.depth * rowHeight);
+				const ImVec2 maxCorner(x1, minCorner.y + rowHeight - 1.0f);
+
+				drawList->AddRectFilled(minCorner, maxCorner, zoneColor(zone.name));
+				if (ImGui::CalcTextSize(zone.name).x + 4.0f < x1 - x0) {
+					drawList->AddText(ImVec2(x0 + 2.0f, minCorner.y + 2.0f), IM_COL32_WHITE, zone.name);
+				}
+				if (ImGui::IsMouseHoveringRect(minCorner, maxCorner)) {
+					ImGui::SetTooltip("%s\n%.3f ms", zone.name, (zone.end - zone.start) / 1.0e6);
+				}
+			}
+			begin = end;
+		}
+	}
+
+	// Hierarchical view of the same zones
+	if (ImGui::CollapsingHeader("Zones")) {
+		for (size_t begin = 0; begin < zones.size();) {
+			size_t end = begin;
+			while (end < zones.size() && zones[end].threadId == zones[begin].threadId) {
+				++end;
+			}
+
+			ImGui::PushID(static_cast<int>(zones[begin].threadId));
+			if (ImGui::TreeNode("Thread", "%s", profiler.getThreadName(zones[begin].threadId).c_str())) {
+				for (size_t i = begin; i < end;) {
+					i = zoneTree(zones, i, end, frameTime);
+				}
+				ImGui::TreePop();
+			}
+			ImGui::PopID();
+			begin = end;
+		}
+	}
+
+	ImGui::End();
+}
+
+void
+EngineGUI::memory() {
+	EngineUtilities::MemoryTracker& tracker = EngineUtilities::MemoryTracker::getInstance();
+	ImGui::Begin("Memory");
+
+	if (ImGui::Button("Dump JSON")) {
+		memoryStatus = tracker.writeJson("memory.json") ? "Saved memory.json" : "Can't write memory.json";
+	}
+	if (!memoryStatus.empty()) {
+		ImGui::SameLine();
+		ImGui::TextUnformatted(memoryStatus.c_str());
+	}
+
+	ImGui::Text("Live: %.2f MB  Peak: %.2f MB",
+		tracker.getLiveBytes() / (1024.0 * 1024.0), tracker.getPeakBytes() / (1024.0 * 1024.0));
+	ImGui::Text("Last frame: %llu allocations, %llu bytes  Max: %llu allocations",
+		static_cast<unsigned long long>(tracker.getLastFrameAllocations()),
+		static_cast<unsigned long long>(tracker.getLastFrameBytes()),
+		static_cast<unsigned long long>(tracker.getMaxFrameAllocations()));
+
+	if (!EngineUtilities::MemoryTracker::TRACKS_OBJECTS) {
+		ImGui::TextDisabled("Smart pointers aren't tracked in this build (HORCHATA_MEMORY_TRACKER=0)");
+	}
+
+	const EngineUtilities::FrameArena& arena = EngineUtilities::FrameArena::getInstance();
+	ImGui::Text("Frame arena: %zu / %zu bytes (peak %zu)", arena.getUsed(), arena.getCapacity(), arena.getPeak());
+
+	// Allocations per frame, a steady game loop should stay flat at zero
+	allocationHistory[allocationHistoryOffset] = static_cast<float>(tracker.getLastFrameAllocations());
+	allocationHistoryOffset = (allocationHistoryOffset + 1) % allocationHistory.size();
+	ImGui::PlotHistogram("##Allocations", allocationHistory.data(), static_cast<int>(allocationHistory.size()),
+		static_cast<int>(allocationHistoryOffset), "allocations per frame", 0.0f, FLT_MAX,
+		ImVec2(ImGui::GetContentRegionAvail().x, 60.0f));
+	ImGui::Separator();
+
+	static ImGuiTextFilter filter;
+	filter.Draw("Filter", 180.0f);
+
+	if (ImGui::BeginTable("MemoryTypes", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("Type");
+		ImGui::TableSetupColumn("Live");
+		ImGui::TableSetupColumn("Bytes");
+		ImGui::TableSetupColumn("Peak");
+		ImGui::TableSetupColumn("Allocations");
+		ImGui::TableHeadersRow();
+
+		for (const EngineUtilities::MemoryTypeStats& stats : tracker.snapshot()) {
+			if (!filter.PassFilter(stats.name.c_str())) {
+				continue;
+			}
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(stats.name.c_str());
+			ImGui::TableNextColumn();
+			ImGui::Text("%lld", static_cast<long long>(stats.liveCount));
+			ImGui::TableNextColumn();
+			ImGui::Text("%lld", static_cast<long long>(stats.liveBytes));
+			ImGui::TableNextColumn();
+			ImGui::Text("%lld", static_cast<long long>(stats.peakBytes));
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", static_cast<unsigned long long>(stats.allocations));
+		}
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
+
 void EngineGUI::vec2Control(const std::string& label, float* values, float resetValues, float columnWidth) {
 	ImGuiIO& io = ImGui::GetIO();
 	auto boldFont = io.Fonts->Fonts[0];
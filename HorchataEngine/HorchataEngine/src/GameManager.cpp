@@ -1,125 +1,136 @@
 #include "GameManager.h"
 #include "ECS/Transform.h"
+#include "Profiler.h"
 #include <algorithm>
-#include <SFML/Graphics/Image.hpp>
 
 GameManager::GameManager()
+	: m_trackMask(EngineUtilities::MakeShared<TrackCollisionMask>())
 {
 }
 
-void GameManager::init(EngineUtilities::TSharedPointer<Actor> trackActor, std::vector<EngineMath::Vector2> waypoints)
+void GameManager::init(EngineUtilities::TSharedPointer<Actor> trackActor, const EngineUtilities::TSharedPointer<Path>& path, const std::string& trackImageFile)
 {
 	m_trackActor = trackActor;
-	m_waypoints = waypoints;
+	m_path = path;
 
-	// Load the track texture as an image for collision checking
+	// Build the death mask from the track image on disk, no GPU readback needed
+	std::string maskFile = trackImageFile;
 	auto textureComponent = m_trackActor->getComponent<Texture>();
-	if (textureComponent) {
-		const sf::Texture* texture = &textureComponent->getTexture();
-
-		if (texture) {
-			m_trackCollisionImage = texture->copyToImage();
-		}
+	if (maskFile.empty() && textureComponent) {
+		maskFile = textureComponent->getFileName();
+	}
+	auto trackTransform = m_trackActor->getComponent<Transform>();
+	auto trackShape = m_trackActor->getComponent<CShape>();
+	if (!maskFile.empty() && trackTransform && m_trackMask->loadFromFile(maskFile, sf::Color::Black, true)) {
+		// The texture is stretched over the track shape
+		sf::FloatRect localBounds = trackShape ? trackShape->getLocalBounds() : sf::FloatRect();
+		EngineMath::Vector2 scale = trackTransform->getScale();
+		EngineMath::Vector2 size(localBounds.size.x * scale.x, localBounds.size.y * scale.y);
+		EngineMath::Vector2 origin(trackTransform->getOrigin().x * scale.x, trackTransform->getOrigin().y * scale.y);
+		m_trackMask->setWorldBounds(trackTransform->getPosition() - origin, size);
 	}
 }
 
 void GameManager::update(float deltaTime, std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers, EngineUtilities::TSharedPointer<APlayer>& player)
 {
+	PROFILE_SCOPE("GameManager::update");
 	m_timeInSeconds += deltaTime;
 
+	updateProgress(racers, player);
 	updateRanks(racers, player);
-	checkCollisions(player);
+	checkCollisions(racers, player);
+}
 
-	// Update waypoints for each bot
-	for (auto& racer : racers) {
-		EngineMath::Vector2 currentPos = racer->getComponent<Transform>()->getPosition();
-		EngineMath::Vector2 targetWaypoint = m_waypoints[racer->getCurrentWaypointIndex()];
-		float distance = EngineMath::Vector2::distance(currentPos, targetWaypoint);
-		if (distance < 50.f) {
-			size_t nextIndex = (racer->getCurrentWaypointIndex() + 1) % m_waypoints.size();
-			racer->setCurrentWaypointIndex(nextIndex);
-
-			// If the bot has completed a lap
-			if (nextIndex == 0) {
-				racer->setLapCount(racer->getLapCount() + 1);
-			}
-		}
-	}
+void GameManager::updateProgress(std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers, EngineUtilities::TSharedPointer<APlayer>& player)
+{
+	PROFILE_SCOPE("GameManager::updateProgress");
 
-	// Similar logic for the player
-	EngineMath::Vector2 playerPos = player->getComponent<Transform>()->getPosition();
-	EngineMath::Vector2 playerTargetWaypoint = m_waypoints[player->getCurrentWaypointIndex()];
-	float playerDistance = EngineMath::Vector2::distance(playerPos, playerTargetWaypoint);
-	if (playerDistance < 50.f) {
-		size_t nextIndex = (player->getCurrentWaypointIndex() + 1) % m_waypoints.size();
-		player->setCurrentWaypointIndex(nextIndex);
-
-		// If the player has completed a lap
-		if (nextIndex == 0) {
-			player->setLapCount(player->getLapCount() + 1);
-		}
+	// Gather the positions, player first, so the progress pass runs over one array
+	m_positions.resize(racers.size() + 1);
+	m_positions[0] = player->getComponent<Transform>()->getPosition();
+	for (size_t i = 0; i < racers.size(); ++i) {
+		m_positions[i + 1] = racers[i]->getComponent<Transform>()->getPosition();
+	}
+	m_progress.update(*m_path, m_positions);
+
+	// Waypoint and lap of every kart come from the same pass
+	player->setCurrentWaypointIndex(m_progress.getNextWaypoint(0, *m_path));
+	player->setLapCount(m_progress.getLap(0));
+	for (size_t i = 0; i < racers.size(); ++i) {
+		ARacer& racer = *racers[i];
+		racer.setCurrentWaypointIndex(m_progress.getNextWaypoint(i + 1, *m_path));
+		racer.setLapCount(m_progress.getLap(i + 1));
+		racer.setPathDistance(m_progress.getLapDistance(i + 1));
 	}
 }
 
 void GameManager::updateRanks(std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers, EngineUtilities::TSharedPointer<APlayer>& player)
 {
-	m_leaderboard.clear();
+	PROFILE_SCOPE("GameManager::updateRanks");
+	m_ranking.resize(racers.size() + 1);
 
-	// Create a list of all racers
-	std::vector<std::pair<EngineUtilities::TSharedPointer<Actor>, float>> allRacers;
-
-	allRacers.push_back({ player, player->getLapCount() * m_waypoints.size() + player->getCurrentWaypointIndex() });
-	for (auto& racer : racers) {
-		allRacers.push_back({ racer, racer->getLapCount() * m_waypoints.size() + racer->getCurrentWaypointIndex() });
+	// Same participant order as updateProgress: player first, then racers
+	m_ranking.setProgress(0, player.get(), m_progress.getProgress(0));
+	for (size_t i = 0; i < racers.size(); ++i) {
+		m_ranking.setProgress(i + 1, racers[i].get(), m_progress.getProgress(i + 1));
 	}
+	m_ranking.update();
+}
 
-	// Sort the list by position on the track (highest to lowest)
-	std::sort(allRacers.begin(), allRacers.end(), [](const auto& a, const auto& b) {
-		return a.second > b.second;
-		});
+void GameManager::checkCollisions(std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers, EngineUtilities::TSharedPointer<APlayer>& player)
+{
+	PROFILE_SCOPE("GameManager::checkCollisions");
+	if (m_trackMask->isEmpty()) return;
 
-	// Fill the leaderboard
-	for (size_t i = 0; i < allRacers.size(); ++i) {
-		m_leaderboard.push_back({ allRacers[i].first->getName(), i + 1 });
+	auto playerTransform = player->getComponent<Transform>();
+	if (playerTransform) {
+		checkTrackCollision(*playerTransform, player->getCurrentWaypointIndex());
+	}
+
+	for (auto& racer : racers) {
+		auto racerTransform = racer->getComponent<Transform>();
+		if (racerTransform) {
+			checkTrackCollision(*racerTransform, racer->getCurrentWaypointIndex());
+		}
 	}
 }
 
-void GameManager::checkCollisions(EngineUtilities::TSharedPointer<APlayer>& player)
+void GameManager::checkTrackCollision(Transform& transform, size_t currentWaypoint)
 {
-	auto transform = player->getComponent<Transform>();
-	if (!transform) return;
+	// One bit test per kart; positions outside the track are left alone
+	if (m_trackMask->isDeath(transform.getPosition())) {
+		size_t lastWaypointIndex = (currentWaypoint > 0) ? currentWaypoint - 1 : m_path->getPointCount() - 1;
+		transform.teleport(m_path->getPoint(lastWaypointIndex));
+	}
+}
 
-	// Get the player's position in world coordinates
-	EngineMath::Vector2 playerPos = transform->getPosition();
+void GameManager::resolveRacerCollisions(std::vector<EngineUtilities::TSharedPointer<ARacer>>& racers, EngineUtilities::TSharedPointer<APlayer>& player)
+{
+	PROFILE_SCOPE("GameManager::resolveRacerCollisions");
+	Registry& registry = Registry::getInstance();
 
-	// Convert the player's position to track image coordinates
-	auto trackTransform = m_trackActor->getComponent<Transform>();
-	if (!trackTransform) return;
-
-	EngineMath::Vector2 trackOrigin = trackTransform->getOrigin();
-	EngineMath::Vector2 trackPosition = trackTransform->getPosition();
-	EngineMath::Vector2 trackScale = trackTransform->getScale();
-	sf::IntRect trackBounds = trackTransform->getGlobalBounds();
-
-	// Normalize the player's position to the track (coordinates 0-1)
-		// sf::FloatRect uses .left, .top, .width, .height in SFML, but if your sf::Rect<float> does not, use .x, .y, .width, .height
-	float normalizedX = (playerPos.x - trackBounds.position.x) / trackBounds.size.x;
-	float normalizedY = (playerPos.y - trackBounds.position.y) / trackBounds.size.y;
-
-	unsigned int pixelX = static_cast<unsigned int>(normalizedX * m_trackCollisionImage.getSize().x);
-	unsigned int pixelY = static_cast<unsigned int>(normalizedY * m_trackCollisionImage.getSize().y);
-
-	if (pixelX < m_trackCollisionImage.getSize().x &&
-		pixelY < m_trackCollisionImage.getSize().y)
-	{
-		sf::Color pixelColor = m_trackCollisionImage.getPixel(sf::Vector2u(pixelX, pixelY));
-
-		// If the pixel is black, it is a "death" zone
-		if (pixelColor == sf::Color::Black) {
-			size_t lastWaypointIndex = (player->getCurrentWaypointIndex() > 0) ? player->getCurrentWaypointIndex() - 1 : m_waypoints.size() - 1;
-			transform->setPosition(m_waypoints[lastWaypointIndex]);
-		}
+	m_racerGrid.clear();
+	m_racerGrid.insert(player->getEntityID(), player->getComponent<Transform>()->getPosition(), m_kartRadius);
+	for (auto& racer : racers) {
+		m_racerGrid.insert(racer->getEntityID(), racer->getComponent<Transform>()->getPosition(), m_kartRadius);
 	}
+	m_racerGrid.build();
+
+	// Split the overlap between both karts along the line between their centers
+	m_racerGrid.forEachOverlappingPair([&registry](const SpatialHashGrid::Entry& a, const SpatialHashGrid::Entry& b) {
+		Transform* first = registry.tryGet<Transform>(a.id);
+		Transform* second = registry.tryGet<Transform>(b.id);
+		if (!first || !second) return;
+
+		EngineMath::Vector2 delta = second->getPosition() - first->getPosition();
+		float distance = delta.length();
+		EngineMath::Vector2 normal = distance > 0.f ? delta / distance : EngineMath::Vector2(1.f, 0.f);
+		float overlap = a.radius + b.radius - distance;
+		if (overlap > 0.f) {
+			first->setPosition(first->getPosition() - normal * (overlap * 0.5f));
+			second->setPosition(second->getPosition() + normal * (overlap * 0.5f));
+		}
+	});
 }
 
 void GameManager::renderHUD(EngineUtilities::TSharedPointer<Window>& window)
@@ -128,12 +139,23 @@ void GameManager::renderHUD(EngineUtilities::TSharedPointer<Window>& window)
 
 	// Stopwatch
 	ImGui::Text("Time: %.2f", m_timeInSeconds);
+	if (m_progress.size() > 0) {
+		ImGui::Text("Lap: %d  Position: %d", m_progress.getLap(0), static_cast<int>(m_ranking.getRank(0)));
+	}
 
 	// Leaderboard
 	ImGui::Text("Leaderboard:");
 	ImGui::Separator();
-	for (const auto& entry : m_leaderboard) {
-		ImGui::Text("%d. %s", entry.second, entry.first.c_str());
+	// Only the visible rows are formatted, the field can have thousands of karts
+	const std::vector<RaceRanking::Entry>& leaderboard = m_ranking.getEntries();
+	ImGuiListClipper clipper;
+	clipper.Begin(static_cast<int>(leaderboard.size()));
+	while (clipper.Step()) {
+		for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+			const RaceRanking::Entry& entry = leaderboard[i];
+			ImGui::Text("%d. %s (lap %d)", i + 1, entry.actor ? entry.actor->getName().c_str() : "",
+			            m_progress.getLap(entry.participant));
+		}
 	}
 
 	ImGui::End();
@@ -0,0 +1,111 @@
+#include "Path.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+Path::Path(std::vector<EngineMath::Vector2> points, bool closed)
+  : m_points(std::move(points)), m_closed(closed) {
+  if (m_points.size() < 2) {
+    ERROR("Path", "Path", "A path needs at least two points");
+  }
+
+  const size_t segmentCount = m_closed ? m_points.size() : m_points.size() - 1;
+  m_segmentDeltas.reserve(segmentCount);
+  m_segmentLengths.reserve(segmentCount);
+  m_segmentInvLengthsSq.reserve(segmentCount);
+  m_cumulativeLengths.reserve(segmentCount + 1);
+
+  float total = 0.f;
+  m_cumulativeLengths.push_back(0.f);
+  for (size_t i = 0; i < segmentCount; ++i) {
+    const EngineMath::Vector2 delta = m_points[(i + 1) % m_points.size()] - m_points[i];
+    const float lengthSq = delta.lengthSq();
+    const float length = delta.length();
+    m_segmentDeltas.push_back(delta);
+    m_segmentLengths.push_back(length);
+    m_segmentInvLengthsSq.push_back(lengthSq > 0.f ? 1.f / lengthSq : 0.f);
+    total += length;
+    m_cumulativeLengths.push_back(total);
+  }
+}
+
+void
+Path::projectOnSegment(const EngineMath::Vector2& position, size_t segment, PathProjection& best) const {
+  const EngineMath::Vector2& start = m_points[segment];
+  const EngineMath::Vector2& delta = m_segmentDeltas[segment];
+  float t = (position - start).dot(delta) * m_segmentInvLengthsSq[segment];
+  t = std::min(1.f, std::max(0.f, t));
+
+  const EngineMath::Vector2 point = start + delta * t;
+  const float distanceSq = (position - point).lengthSq();
+  if (distanceSq < best.distanceSq) {
+    best.point = point;
+    best.distanceSq = distanceSq;
+    best.distance = m_cumulativeLengths[segment] + m_segmentLengths[segment] * t;
+    best.segment = segment;
+  }
+}
+
+PathProjection
+Path::project(const EngineMath::Vector2& position) const {
+  PathProjection best;
+  best.distanceSq = std::numeric_limits<float>::max();
+  for (size_t segment = 0; segment < m_segmentLengths.size(); ++segment) {
+    projectOnSegment(position, segment, best);
+  }
+  return best;
+}
+
+PathProjection
+Path::project(const EngineMath::Vector2& position, size_t hintSegment, size_t searchRadius) const {
+  const size_t segmentCount = m_segmentLengths.size();
+  if (2 * searchRadius + 1 >= segmentCount) {
+    return project(position);
+  }
+
+  PathProjection best;
+  best.distanceSq = std::numeric_limits<float>::max();
+  hintSegment %= segmentCount;
+  for (size_t offset = 0; offset <= 2 * searchRadius; ++offset) {
+    size_t segment;
+    if (m_closed) {
+      segment = (hintSegment + segmentCount - searchRadius + offset) % segmentCount;
+    }
+    else {
+      // Slide the window instead of wrapping past the ends
+      const size_t first = std::min(hintSegment > searchRadius ? hintSegment - searchRadius : 0,
+                                    segmentCount - 2 * searchRadius - 1);
+      segment = first + offset;
+    }
+    projectOnSegment(position, segment, best);
+  }
+  return best;
+}
+
+float
+Path::wrapDistance(float distance) const {
+  const float length = getLength();
+  if (!m_closed || length <= 0.f) {
+    return std::min(length, std::max(0.f, distance));
+  }
+  distance = std::fmod(distance, length);
+  return distance < 0.f ? distance + length : distance;
+}
+
+size_t
+Path::segmentAtDistance(float distance) const {
+  distance = wrapDistance(distance);
+  // First point past the distance; the segment starts at the point before it
+  auto it = std::upper_bound(m_cumulativeLengths.begin(), m_cumulativeLengths.end(), distance);
+  const size_t point = static_cast<size_t>(it - m_cumulativeLengths.begin());
+  return std::min(point > 0 ? point - 1 : 0, m_segmentLengths.size() - 1);
+}
+
+EngineMath::Vector2
+Path::pointAtDistance(float distance) const {
+  distance = wrapDistance(distance);
+  const size_t segment = segmentAtDistance(distance);
+  const float length = m_segmentLengths[segment];
+  const float t = length > 0.f ? (distance - m_cumulativeLengths[segment]) / length : 0.f;
+  return m_points[segment] + m_segmentDeltas[segment] * std::min(1.f, t);
+}
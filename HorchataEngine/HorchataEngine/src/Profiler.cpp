@@ -0,0 +1,179 @@
+#include "Profiler.h"
+#include <algorithm>
+
+thread_local Profiler::ThreadBuffer* Profiler::t_threadBuffer = nullptr;
+
+namespace {
+  /**
+   * @brief Writes a string as a JSON string literal.
+   */
+  void
+  writeJsonString(std::ostream& output, const std::string& text) {
+    output << '"';
+    for (char c : text) {
+      switch (c) {
+      case '"':  output << "\\\""; break;
+      case '\\': output << "\\\\"; break;
+      case '\n': output << "\\n"; break;
+      case '\t': output << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) >= 0x20) {
+          output << c;
+        }
+        break;
+      }
+    }
+    output << '"';
+  }
+}
+
+Profiler::Profiler()
+  : m_epoch(now()), m_frameStart(m_epoch), m_frameHistory(FRAME_HISTORY, 0.0f) {
+}
+
+Profiler::ThreadBuffer&
+Profiler::threadBuffer() {
+  if (t_threadBuffer) {
+    return *t_threadBuffer;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_buffers.push_back(EngineUtilities::MakeUnique<ThreadBuffer>());
+  ThreadBuffer& buffer = *m_buffers.back();
+  buffer.zones.resize(RING_CAPACITY);
+  buffer.id = static_cast<uint32_t>(m_buffers.size() - 1);
+  buffer.name = "Thread " + std::to_string(buffer.id);
+  t_threadBuffer = &buffer;
+  return buffer;
+}
+
+void
+Profiler::setThreadName(const std::string& name) {
+  ThreadBuffer& buffer = threadBuffer();
+  std::lock_guard<std::mutex> lock(buffer.mutex);
+  buffer.name = name;
+}
+
+const char*
+Profiler::internName(const std::string& name) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_names.insert(name).first->c_str();
+}
+
+uint32_t
+Profiler::enterZone() {
+  return threadBuffer().depth++;
+}
+
+void
+Profiler::leaveZone(const char* name, uint64_t start, uint32_t depth) {
+  const uint64_t end = now();
+  ThreadBuffer& buffer = threadBuffer();
+  buffer.depth = depth;
+
+  std::lock_guard<std::mutex> lock(buffer.mutex);
+  ProfileZone& zone = buffer.zones[buffer.written % RING_CAPACITY];
+  zone.name = name;
+  zone.start = start;
+  zone.end = end;
+  zone.depth = depth;
+  zone.threadId = buffer.id;
+  ++buffer.written;
+}
+
+void
+Profiler::beginFrame() {
+  m_frameStart = now();
+}
+
+void
+Profiler::endFrame() {
+  const uint64_t frameEnd = now();
+  m_frameHistory[m_frameHistoryIndex] = static_cast<float>(frameEnd - m_frameStart) / 1.0e6f;
+  m_frameHistoryIndex = (m_frameHistoryIndex + 1) % FRAME_HISTORY;
+
+  // Stopped: keep showing the last recorded frame
+  if (!isEnabled()) {
+    return;
+  }
+
+  m_frameZones.clear();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& bufferPtr : m_buffers) {
+    ThreadBuffer& buffer = *bufferPtr;
+    std::lock_guard<std::mutex> bufferLock(buffer.mutex);
+
+    // Zones overwritten before this frame gathered them are lost
+    uint64_t first = buffer.collected;
+    if (buffer.written > RING_CAPACITY && first < buffer.written - RING_CAPACITY) {
+      first = buffer.written - RING_CAPACITY;
+    }
+    for (uint64_t i = first; i < buffer.written; ++i) {
+      m_frameZones.push_back(buffer.zones[i % RING_CAPACITY]);
+    }
+    buffer.collected = buffer.written;
+  }
+
+  std::sort(m_frameZones.begin(), m_frameZones.end(), [](const ProfileZone& a, const ProfileZone& b) {
+    if (a.threadId != b.threadId) return a.threadId < b.threadId;
+    if (a.start != b.start) return a.start < b.start;
+    return a.depth < b.depth;
+  });
+  m_frameZonesStart = m_frameStart;
+  m_frameZonesEnd = frameEnd;
+}
+
+std::string
+Profiler::getThreadName(uint32_t threadId) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (threadId >= m_buffers.size()) {
+    return "Thread " + std::to_string(threadId);
+  }
+  std::lock_guard<std::mutex> bufferLock(m_buffers[threadId]->mutex);
+  return m_buffers[threadId]->name;
+}
+
+bool
+Profiler::exportChromeTrace(const std::string& fileName) {
+  std::ofstream output(fileName, std::ios::trunc);
+  if (!output) {
+    MESSAGE("Profiler", "exportChromeTrace", "FAILED, can't write " + fileName);
+    return false;
+  }
+
+  // Complete events ("X") with timestamps in microseconds since the profiler started
+  output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  output.setf(std::ios::fixed);
+  output.precision(3);
+  bool first = true;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& bufferPtr : m_buffers) {
+    ThreadBuffer& buffer = *bufferPtr;
+    std::lock_guard<std::mutex> bufferLock(buffer.mutex);
+
+    output << (first ? "\n" : ",\n");
+    first = false;
+    output << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer.id << ",\"args\":{\"name\":";
+    writeJsonString(output, buffer.name);
+    output << "}}";
+
+    const uint64_t count = std::min<uint64_t>(buffer.written, RING_CAPACITY);
+    for (uint64_t i = buffer.written - count; i < buffer.written; ++i) {
+      const ProfileZone& zone = buffer.zones[i % RING_CAPACITY];
+      const uint64_t start = zone.start > m_epoch ? zone.start - m_epoch : 0;
+      output << ",\n{\"name\":";
+      writeJsonString(output, zone.name ? zone.name : "");
+      output << ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":0,\"tid\":" << zone.threadId
+             << ",\"ts\":" << start / 1000.0
+             << ",\"dur\":" << (zone.end - zone.start) / 1000.0 << "}";
+    }
+  }
+  output << "\n]}\n";
+
+  if (!output) {
+    MESSAGE("Profiler", "exportChromeTrace", "FAILED, can't write " + fileName);
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,59 @@
+#include "RaceProgress.h"
+#include "Threading/ThreadPool.h"
+
+void
+RaceProgress::resize(size_t participants) {
+  m_progress.resize(participants, 0.f);
+  m_lapDistances.resize(participants, 0.f);
+  m_laps.resize(participants, 0);
+  m_segments.resize(participants, 0);
+  m_placed.resize(participants, 0);
+}
+
+void
+RaceProgress::update(const Path& path, const std::vector<EngineMath::Vector2>& positions) {
+  resize(positions.size());
+  if (positions.size() <= GRAIN_SIZE) {
+    updateRange(path, positions, 0, positions.size());
+    return;
+  }
+  ThreadPool::getInstance().parallelFor(positions.size(), GRAIN_SIZE,
+    [this, &path, &positions](size_t begin, size_t end) {
+      updateRange(path, positions, begin, end);
+    });
+}
+
+void
+RaceProgress::updateRange(const Path& path,
+                          const std::vector<EngineMath::Vector2>& positions,
+                          size_t begin,
+                          size_t end) {
+  const float length = path.getLength();
+  const float invLength = length > 0.f ? 1.f / length : 0.f;
+  const float halfLength = length * 0.5f;
+
+  for (size_t i = begin; i < end; ++i) {
+    const PathProjection projection = m_placed[i] ? path.project(positions[i], m_segments[i])
+                                                  : path.project(positions[i]);
+
+    if (!m_placed[i]) {
+      // A kart placed behind the start (on the grid) has not begun lap 0 yet
+      m_laps[i] = projection.distance > halfLength ? -1 : 0;
+    }
+    else {
+      // A jump of more than half a lap means the kart went over the start of the path
+      const float delta = projection.distance - m_lapDistances[i];
+      if (delta < -halfLength) {
+        ++m_laps[i];
+      }
+      else if (delta > halfLength) {
+        --m_laps[i];
+      }
+    }
+
+    m_placed[i] = 1;
+    m_segments[i] = static_cast<uint32_t>(projection.segment);
+    m_lapDistances[i] = projection.distance;
+    m_progress[i] = static_cast<float>(m_laps[i]) + projection.distance * invLength;
+  }
+}
@@ -0,0 +1,56 @@
+#include "RaceRanking.h"
+
+void
+RaceRanking::resize(size_t participants) {
+  if (participants == m_entries.size()) {
+    return;
+  }
+
+  // Drop the participants past the new count and close the gaps they leave
+  size_t kept = 0;
+  for (size_t i = 0; i < m_entries.size(); ++i) {
+    if (m_entries[i].participant < participants) {
+      m_entries[kept++] = m_entries[i];
+    }
+  }
+  m_entries.resize(kept);
+  m_places.resize(participants);
+
+  for (size_t participant = kept; participant < participants; ++participant) {
+    Entry entry;
+    entry.participant = static_cast<uint32_t>(participant);
+    m_entries.push_back(entry);
+  }
+  for (size_t i = 0; i < m_entries.size(); ++i) {
+    m_places[m_entries[i].participant] = static_cast<uint32_t>(i);
+  }
+  m_dirty = true;
+}
+
+size_t
+RaceRanking::update() {
+  if (!m_dirty) {
+    return 0;
+  }
+  m_dirty = false;
+
+  // Insertion pass: in order entries cost one comparison, the rest move up
+  // past the karts they overtook (a kart that fell back is overtaken)
+  size_t moves = 0;
+  for (size_t i = 1; i < m_entries.size(); ++i) {
+    if (m_entries[i - 1].progress >= m_entries[i].progress) {
+      continue;
+    }
+    const Entry entry = m_entries[i];
+    size_t place = i;
+    while (place > 0 && m_entries[place - 1].progress < entry.progress) {
+      m_entries[place] = m_entries[place - 1];
+      m_places[m_entries[place].participant] = static_cast<uint32_t>(place);
+      --place;
+      ++moves;
+    }
+    m_entries[place] = entry;
+    m_places[entry.participant] = static_cast<uint32_t>(place);
+  }
+  return moves;
+}
@@ -1,34 +1,275 @@
 #include "ResourceManager.h"
+#include "AssetCache.h"
+
+ResourceManager::~ResourceManager() {
+	ThreadPool::getInstance().wait(m_pendingDecodes);
+}
 
 bool
 ResourceManager::loadTexture(const std::string& fileName,
 														 const std::string& extension) {
-	if (m_textures.find(fileName) != m_textures.end()) {
-		return true;
+	TextureHandle handle = m_textures.find(fileName);
+	if (handle.isValid()) {
+		return m_textures.get(handle)->getState() != TextureState::FAILED;
 	}
 		
-	auto texture = EngineUtilities::MakeShared<Texture>(fileName, extension);
-	m_textures[fileName] = texture;
-	return true;
+	// Decoded through the asset cache, so a warm start skips the PNG decode
+	sf::Image image;
+	auto texture = EngineUtilities::MakeShared<Texture>(fileName, extension, getPlaceholderImage());
+	if (!AssetCache::getInstance().loadImage(fileName + "." + extension, image) || !texture->upload(image)) {
+		std::cerr << "[ResourceManager] Texture could not be loaded: " << fileName << ". Keeping the placeholder.\n";
+		texture->markFailed();
+	}
+	m_textures.insert(fileName, texture, textureBytes(texture));
+	return texture->isReady();
 }
 
 EngineUtilities::TSharedPointer<Texture>
-ResourceManager::getTexture(const std::string& fileName) {
-	auto it = m_textures.find(fileName);
-	if (it != m_textures.end()) {
+ResourceManager::loadTextureAsync(const std::string& fileName,
+																	const std::string& extension) {
+	TextureHandle handle = m_textures.find(fileName);
+	if (handle.isValid()) {
+		return m_textures.get(handle);
+	}
+
+	auto texture = EngineUtilities::MakeShared<Texture>(fileName, extension, getPlaceholderImage());
+	m_textures.insert(fileName, texture, textureBytes(texture));
+
+	// The job only touches the file and the decoded queue; the texture (and its
+	// non-atomic reference count) stays on the main thread
+	m_pendingDecodes.fetch_add(1, std::memory_order_relaxed);
+	const std::string path = fileName + "." + extension;
+	ThreadPool::getInstance().submit([this, fileName, path]() {
+		DecodedImage decoded;
+		decoded.fileName = fileName;
+		decoded.success = AssetCache::getInstance().loadImage(path, decoded.image);
+
+		std::lock_guard<std::mutex> lock(m_decodedMutex);
+		m_decoded.push_back(std::move(decoded));
+	}, &m_pendingDecodes);
+
+	return texture;
+}
+
+size_t
+ResourceManager::processUploads(size_t byteBudget) {
+	std::vector<DecodedImage> ready;
+	{
+		std::lock_guard<std::mutex> lock(m_decodedMutex);
+		ready.swap(m_decoded);
+	}
+
+	size_t uploaded = 0;
+	size_t spent = 0;
+	for (; uploaded < ready.size(); ++uploaded) {
+		DecodedImage& decoded = ready[uploaded];
+		const size_t bytes = static_cast<size_t>(decoded.image.getSize().x) * decoded.image.getSize().y * 4;
+		if (uploaded > 0 && spent + bytes > byteBudget) {
+			break;
+		}
+		spent += bytes;
+
+		// Textures evicted while their file was decoding are dropped
+		TextureHandle handle = m_textures.find(decoded.fileName);
+		if (!handle.isValid()) {
+			continue;
+		}
+		EngineUtilities::TSharedPointer<Texture> texture = m_textures.get(handle);
+		if (!decoded.success || !texture->upload(decoded.image)) {
+			texture->markFailed();
+			std::cerr << "[ResourceManager] Texture could not be loaded: " << decoded.fileName << ". Keeping the placeholder.\n";
+		}
+		m_textures.setBytes(handle, textureBytes(texture));
+	}
+
+	// Whatever did not fit in the budget goes back to the front of the queue
+	if (uploaded < ready.size()) {
+		std::lock_guard<std::mutex> lock(m_decodedMutex);
+		m_decoded.insert(m_decoded.begin(),
+		                 std::make_move_iterator(ready.begin() + uploaded),
+		                 std::make_move_iterator(ready.end()));
+	}
+
+	m_textures.evict(m_memoryBudget);
+	m_textures.nextFrame();
+	reportMemoryUsage();
+	return uploaded;
+}
+
+void
+ResourceManager::reportMemoryUsage() {
+	EngineUtilities::MemoryTracker& tracker = EngineUtilities::MemoryTracker::getInstance();
+	static const uint32_t textureSlot = tracker.registerName("Texture memory");
+	static const uint32_t decodedSlot = tracker.registerName("Decoded images");
+
+	tracker.setUsage(textureSlot,
+	                 static_cast<int64_t>(m_textures.size()),
+	                 static_cast<int64_t>(m_textures.getResidentBytes()));
+
+	int64_t decodedBytes = 0;
+	std::lock_guard<std::mutex> lock(m_decodedMutex);
+	for (const DecodedImage& decoded : m_decoded) {
+		decodedBytes += static_cast<int64_t>(decoded.image.getSize().x) * decoded.image.getSize().y * 4;
+	}
+	tracker.setUsage(decodedSlot, static_cast<int64_t>(m_decoded.size()), decodedBytes);
+}
+
+TextureHandle
+ResourceManager::acquireTexture(const std::string& fileName,
+																const std::string& extension) {
+	TextureHandle handle = m_textures.find(fileName);
+	if (!handle.isValid()) {
+		loadTextureAsync(fileName, extension);
+		handle = m_textures.find(fileName);
+	}
+	return handle;
+}
+
+void
+ResourceManager::waitForLoads() {
+	ThreadPool::getInstance().wait(m_pendingDecodes);
+	processUploads(static_cast<size_t>(-1));
+}
+
+bool
+ResourceManager::isLoading() {
+	if (m_pendingDecodes.load(std::memory_order_acquire) > 0) {
+		return true;
+	}
+	std::lock_guard<std::mutex> lock(m_decodedMutex);
+	return !m_decoded.empty();
+}
+
+bool
+ResourceManager::buildAtlas(const std::vector<std::string>& fileNames,
+														const std::string& extension,
+														const std::string& cacheFile) {
+	std::vector<std::string> paths;
+	paths.reserve(fileNames.size());
+	for (const std::string& fileName : fileNames) {
+		paths.push_back(fileName + "." + extension);
+	}
+
+	const uint64_t signature = TextureAtlas::computeSignature(paths);
+	TextureAtlas atlas;
+	bool allLoaded = true;
+
+	if (cacheFile.empty() || !atlas.loadFromFile(cacheFile, signature)) {
+		// Decode every file in parallel, then pack on this thread
+		std::vector<sf::Image> images(fileNames.size());
+		std::vector<char> decoded(fileNames.size(), 0);
+		ThreadPool::getInstance().parallelFor(fileNames.size(), 1,
+			[&images, &decoded, &paths](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i) {
+					decoded[i] = AssetCache::getInstance().loadImage(paths[i], images[i]) ? 1 : 0;
+				}
+			});
+
+		for (size_t i = 0; i < fileNames.size(); ++i) {
+			if (!decoded[i]) {
+				std::cerr << "[ResourceManager] Texture could not be loaded: " << fileNames[i] << ". Keeping the placeholder.\n";
+				allLoaded = false;
+				continue;
+			}
+			if (!atlas.add(fileNames[i], images[i]) && !m_textures.find(fileNames[i]).isValid()) {
+				// Too big to share a page, keep it as its own texture
+				auto texture = EngineUtilities::MakeShared<Texture>(fileNames[i], extension, getPlaceholderImage());
+				texture->upload(images[i]);
+				m_textures.insert(fileNames[i], texture, textureBytes(texture));
+			}
+		}
+		if (!atlas.pack()) {
+			allLoaded = false;
+		}
+
+		// Only a complete atlas is cached; a failed write just means repacking next run
+		if (!cacheFile.empty() && allLoaded) {
+			atlas.saveToFile(cacheFile, signature);
+		}
+	}
+
+	const size_t firstPage = m_atlasPages.size();
+	std::vector<TextureHandle> pageHandles;
+	for (size_t page = 0; page < atlas.getPageCount(); ++page) {
+		const std::string pageName = "atlas_" + std::to_string(firstPage + page);
+		auto texture = EngineUtilities::MakeShared<Texture>(pageName, "png", getPlaceholderImage());
+		if (!texture->upload(atlas.getPage(page))) {
+			allLoaded = false;
+		}
+		// Pages are kept by m_atlasPages, the table only accounts for their memory
+		m_atlasPages.push_back(texture);
+		pageHandles.push_back(m_textures.insert(pageName, texture, textureBytes(texture)));
+	}
+	for (const auto& entry : atlas.getRegions()) {
+		m_atlasRegions[entry.first] = TextureRegion{ m_atlasPages[firstPage + entry.second.page], entry.second.rect,
+		                                             pageHandles[entry.second.page] };
+	}
+
+	// Files the cached atlas did not pack (too big) still need their own texture
+	for (size_t i = 0; i < fileNames.size(); ++i) {
+		if (m_atlasRegions.find(fileNames[i]) == m_atlasRegions.end() &&
+		    !m_textures.find(fileNames[i]).isValid()) {
+			loadTextureAsync(fileNames[i], extension);
+		}
+	}
+	return allLoaded;
+}
+
+TextureRegion
+ResourceManager::getTextureRegion(const std::string& fileName) {
+	auto it = m_atlasRegions.find(fileName);
+	if (it != m_atlasRegions.end()) {
 		return it->second;
 	}
+	TextureHandle handle = m_textures.find(fileName);
+	if (handle.isValid()) {
+		return TextureRegion{ m_textures.get(handle), sf::IntRect(), handle };
+	}
+	return TextureRegion{ getTexture(fileName), sf::IntRect() };
+}
+
+EngineUtilities::TSharedPointer<Texture>
+ResourceManager::getTexture(const std::string& fileName) {
+	TextureHandle handle = m_textures.find(fileName);
+	if (handle.isValid()) {
+		return m_textures.get(handle);
+	}
 
 	std::cerr << "[ResourceManager] Texture not found: " << fileName << ". Using default texture.\n";
 
+	// The fallback is generated in memory once, nothing is read from disk
 	const std::string defaultKey = "default";
 
-	auto defaultIt = m_textures.find(defaultKey);
-	if (defaultIt != m_textures.end()) {
-		return defaultIt->second;
+	TextureHandle defaultHandle = m_textures.find(defaultKey);
+	if (defaultHandle.isValid()) {
+		return m_textures.get(defaultHandle);
 	}
 
-	auto defaultTexture = EngineUtilities::MakeShared<Texture>(defaultKey, "png");
-	m_textures[defaultKey] = defaultTexture;
+	auto defaultTexture = EngineUtilities::MakeShared<Texture>(defaultKey, "png", getPlaceholderImage());
+	defaultTexture->markFailed();
+	m_textures.insert(defaultKey, defaultTexture, textureBytes(defaultTexture));
 	return defaultTexture;
-}
\ No newline at end of file
+}
+
+const sf::Image&
+ResourceManager::getPlaceholderImage() {
+	// 8x8 magenta and black checkerboard, easy to spot on screen
+	static const sf::Image placeholder = []() {
+		sf::Image image(sf::Vector2u(8, 8), sf::Color::Black);
+		for (unsigned int y = 0; y < 8; ++y) {
+			for (unsigned int x = 0; x < 8; ++x) {
+				if (((x / 4) + (y / 4)) % 2 == 0) {
+					image.setPixel(sf::Vector2u(x, y), sf::Color::Magenta);
+				}
+			}
+		}
+		return image;
+	}();
+	return placeholder;
+}
+
+size_t
+ResourceManager::textureBytes(const EngineUtilities::TSharedPointer<Texture>& texture) {
+	const sf::Vector2u size = texture->getTexture().getSize();
+	return static_cast<size_t>(size.x) * size.y * 4;
+}
@@ -0,0 +1,164 @@
+#include "SpriteBatch.h"
+#include "Window.h"
+#include <algorithm>
+#include <cmath>
+
+void
+SpriteBatch::begin() {
+  for (auto& batch : m_batches) {
+    batch.vertices.clear();
+  }
+  m_nextOrder = 0;
+  m_stats.sprites = 0;
+}
+
+SpriteBatch::Batch&
+SpriteBatch::findBatch(int layer, const sf::Texture* texture, const sf::BlendMode& blendMode) {
+  // Only a handful of textures are alive at once, a linear search beats hashing
+  for (auto& batch : m_batches) {
+    if (batch.layer == layer && batch.texture == texture && batch.blendMode == blendMode) {
+      if (batch.vertices.getVertexCount() == 0) {
+        batch.order = m_nextOrder++;
+      }
+      return batch;
+    }
+  }
+
+  Batch batch;
+  batch.layer = layer;
+  batch.texture = texture;
+  batch.blendMode = blendMode;
+  batch.order = m_nextOrder++;
+  m_batches.push_back(std::move(batch));
+  return m_batches.back();
+}
+
+void
+SpriteBatch::submit(const sf::Shape& shape, int layer, const sf::BlendMode& blendMode) {
+  const size_t pointCount = shape.getPointCount();
+  if (pointCount < 3) {
+    return;
+  }
+
+  // Texture coordinates map the local bounds onto the texture rect, as sf::Shape does
+  sf::Vector2f minPoint = shape.getPoint(0);
+  sf::Vector2f maxPoint = minPoint;
+  for (size_t i = 1; i < pointCount; ++i) {
+    const sf::Vector2f point = shape.getPoint(i);
+    minPoint.x = std::min(minPoint.x, point.x);
+    minPoint.y = std::min(minPoint.y, point.y);
+    maxPoint.x = std::max(maxPoint.x, point.x);
+    maxPoint.y = std::max(maxPoint.y, point.y);
+  }
+  const sf::Vector2f size(maxPoint.x - minPoint.x, maxPoint.y - minPoint.y);
+  const sf::IntRect textureRect = shape.getTextureRect();
+  const sf::Transform& transform = shape.getTransform();
+  const sf::Color color = shape.getFillColor();
+
+  m_shapeVertices.resize(pointCount);
+  for (size_t i = 0; i < pointCount; ++i) {
+    const sf::Vector2f point = shape.getPoint(i);
+    const float u = size.x > 0.f ? (point.x - minPoint.x) / size.x : 0.f;
+    const float v = size.y > 0.f ? (point.y - minPoint.y) / size.y : 0.f;
+
+    sf::Vertex& vertex = m_shapeVertices[i];
+    vertex.position = transform.transformPoint(point);
+    vertex.color = color;
+    vertex.texCoords = sf::Vector2f(textureRect.position.x + textureRect.size.x * u,
+                                    textureRect.position.y + textureRect.size.y * v);
+  }
+
+  // Shapes are convex, a triangle fan from the first point covers them
+  sf::VertexArray& vertices = findBatch(layer, shape.getTexture(), blendMode).vertices;
+  for (size_t i = 1; i + 1 < pointCount; ++i) {
+    vertices.append(m_shapeVertices[0]);
+    vertices.append(m_shapeVertices[i]);
+    vertices.append(m_shapeVertices[i + 1]);
+  }
+
+  if (shape.getOutlineThickness() != 0.f) {
+    appendOutline(shape, layer, blendMode, sf::Vector2f(minPoint.x + size.x * 0.5f, minPoint.y + size.y * 0.5f));
+  }
+  ++m_stats.sprites;
+}
+
+void
+SpriteBatch::appendOutline(const sf::Shape& shape, int layer, const sf::BlendMode& blendMode, const sf::Vector2f& center) {
+  // Same band sf::Shape builds: every point pushed out along the mean normal of its two edges
+  auto edgeNormal = [](const sf::Vector2f& a, const sf::Vector2f& b) {
+    const sf::Vector2f normal(a.y - b.y, b.x - a.x);
+    const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
+    return length != 0.f ? normal / length : normal;
+  };
+
+  const size_t pointCount = shape.getPointCount();
+  const float thickness = shape.getOutlineThickness();
+  const sf::Transform& transform = shape.getTransform();
+  const sf::Color color = shape.getOutlineColor();
+
+  m_shapeVertices.resize(pointCount * 2);
+  for (size_t i = 0; i < pointCount; ++i) {
+    const sf::Vector2f previous = shape.getPoint(i == 0 ? pointCount - 1 : i - 1);
+    const sf::Vector2f point = shape.getPoint(i);
+    const sf::Vector2f next = shape.getPoint(i + 1 == pointCount ? 0 : i + 1);
+
+    sf::Vector2f first = edgeNormal(previous, point);
+    sf::Vector2f second = edgeNormal(point, next);
+    const sf::Vector2f inward = center - point;
+    if (first.x * inward.x + first.y * inward.y > 0.f) {
+      first = -first;
+    }
+    if (second.x * inward.x + second.y * inward.y > 0.f) {
+      second = -second;
+    }
+    const float factor = 1.f + (first.x * second.x + first.y * second.y);
+    const sf::Vector2f normal = factor != 0.f ? (first + second) / factor : first;
+
+    m_shapeVertices[i * 2].position = transform.transformPoint(point);
+    m_shapeVertices[i * 2 + 1].position = transform.transformPoint(point + normal * thickness);
+    m_shapeVertices[i * 2].color = color;
+    m_shapeVertices[i * 2 + 1].color = color;
+  }
+
+  // Outlines are untextured, so they share the untextured batch of the layer; two triangles per edge
+  sf::VertexArray& vertices = findBatch(layer, nullptr, blendMode).vertices;
+  for (size_t i = 0; i < pointCount; ++i) {
+    const size_t inner = i * 2;
+    const size_t nextInner = (i + 1 == pointCount ? 0 : i + 1) * 2;
+    vertices.append(m_shapeVertices[inner]);
+    vertices.append(m_shapeVertices[inner + 1]);
+    vertices.append(m_shapeVertices[nextInner]);
+    vertices.append(m_shapeVertices[nextInner]);
+    vertices.append(m_shapeVertices[inner + 1]);
+    vertices.append(m_shapeVertices[nextInner + 1]);
+  }
+}
+
+void
+SpriteBatch::flush(const EngineUtilities::TSharedPointer<Window>& window) {
+  m_drawOrder.clear();
+  for (size_t i = 0; i < m_batches.size(); ++i) {
+    if (m_batches[i].vertices.getVertexCount() > 0) {
+      m_drawOrder.push_back(i);
+    }
+  }
+  std::sort(m_drawOrder.begin(), m_drawOrder.end(), [this](size_t a, size_t b) {
+    const Batch& first = m_batches[a];
+    const Batch& second = m_batches[b];
+    return first.layer != second.layer ? first.layer < second.layer : first.order < second.order;
+  });
+
+  m_stats.drawCalls = 0;
+  m_stats.vertices = 0;
+  for (size_t index : m_drawOrder) {
+    const Batch& batch = m_batches[index];
+    if (window) {
+      sf::RenderStates states;
+      states.texture = batch.texture;
+      states.blendMode = batch.blendMode;
+      window->draw(batch.vertices, states);
+    }
+    ++m_stats.drawCalls;
+    m_stats.vertices += batch.vertices.getVertexCount();
+  }
+}
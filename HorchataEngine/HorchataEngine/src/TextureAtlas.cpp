@@ -0,0 +1,196 @@
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+
+TextureAtlas::TextureAtlas(unsigned int pageSize, unsigned int padding)
+  : m_pageSize(pageSize), m_padding(padding) {
+}
+
+bool
+TextureAtlas::add(const std::string& name, const sf::Image& image) {
+  const sf::Vector2u size = image.getSize();
+  if (size.x == 0 || size.y == 0 ||
+      size.x + 2 * m_padding > m_pageSize / 2 || size.y + 2 * m_padding > m_pageSize / 2) {
+    return false;
+  }
+  m_pending.push_back({ name, image });
+  return true;
+}
+
+bool
+TextureAtlas::pack() {
+  // Tallest first keeps the shelves tight
+  std::sort(m_pending.begin(), m_pending.end(), [](const PendingImage& a, const PendingImage& b) {
+    return a.image.getSize().y > b.image.getSize().y;
+  });
+
+  // First place every image, then allocate the pages only as tall as they are used
+  const size_t firstPage = m_pages.size();
+  std::vector<unsigned int> pageHeights;
+  unsigned int cursorX = 0;
+  unsigned int shelfY = 0;
+  unsigned int shelfHeight = 0;
+
+  for (const PendingImage& pending : m_pending) {
+    const unsigned int width = pending.image.getSize().x + 2 * m_padding;
+    const unsigned int height = pending.image.getSize().y + 2 * m_padding;
+
+    if (pageHeights.empty() || cursorX + width > m_pageSize) {
+      // Next shelf
+      shelfY += shelfHeight;
+      cursorX = 0;
+      shelfHeight = 0;
+    }
+    if (pageHeights.empty() || shelfY + height > m_pageSize) {
+      // Next page
+      pageHeights.push_back(0);
+      cursorX = 0;
+      shelfY = 0;
+      shelfHeight = 0;
+    }
+
+    Region region;
+    region.page = firstPage + pageHeights.size() - 1;
+    region.rect = sf::IntRect(sf::Vector2i(static_cast<int>(cursorX + m_padding), static_cast<int>(shelfY + m_padding)),
+                              sf::Vector2i(static_cast<int>(pending.image.getSize().x), static_cast<int>(pending.image.getSize().y)));
+    m_regions[pending.name] = region;
+
+    cursorX += width;
+    shelfHeight = std::max(shelfHeight, height);
+    pageHeights.back() = std::max(pageHeights.back(), shelfY + shelfHeight);
+  }
+
+  for (unsigned int height : pageHeights) {
+    m_pages.emplace_back(sf::Vector2u(m_pageSize, height), sf::Color::Transparent);
+  }
+  bool copied = true;
+  for (const PendingImage& pending : m_pending) {
+    const Region& region = m_regions[pending.name];
+    const sf::Vector2u position(static_cast<unsigned int>(region.rect.position.x),
+                                static_cast<unsigned int>(region.rect.position.y));
+    if (!m_pages[region.page].copy(pending.image, position)) {
+      std::cerr << "[TextureAtlas] Can't copy the image into the atlas: " << pending.name << "\n";
+      copied = false;
+    }
+  }
+  m_pending.clear();
+  return copied;
+}
+
+const TextureAtlas::Region*
+TextureAtlas::findRegion(const std::string& name) const {
+  auto it = m_regions.find(name);
+  return it != m_regions.end() ? &it->second : nullptr;
+}
+
+bool
+TextureAtlas::saveToFile(const std::string& manifestFile, uint64_t signature) const {
+  // The atlas is only a cache: a failed write is logged and the next run repacks
+  std::error_code error;
+  const std::filesystem::path folder = std::filesystem::path(manifestFile).parent_path();
+  if (!folder.empty()) {
+    std::filesystem::create_directories(folder, error);
+  }
+
+  // Pages first, so a manifest on disk always has all of its pages
+  std::vector<std::string> pageFiles;
+  for (size_t page = 0; page < m_pages.size(); ++page) {
+    pageFiles.push_back(manifestFile + "_" + std::to_string(page) + ".png");
+    if (!m_pages[page].saveToFile(pageFiles.back())) {
+      std::cerr << "[TextureAtlas] Can't write the atlas page: " << pageFiles.back() << "\n";
+      std::filesystem::remove(manifestFile, error);
+      return false;
+    }
+  }
+
+  std::ofstream manifest(manifestFile, std::ios::trunc);
+  manifest << "HorchataAtlas 2\n";
+  manifest << "signature " << signature << "\n";
+  manifest << "pages " << m_pages.size() << "\n";
+  for (const std::string& pageFile : pageFiles) {
+    manifest << "page " << std::quoted(pageFile) << "\n";
+  }
+  for (const auto& entry : m_regions) {
+    const Region& region = entry.second;
+    manifest << "region " << std::quoted(entry.first) << " " << region.page << " "
+             << region.rect.position.x << " " << region.rect.position.y << " "
+             << region.rect.size.x << " " << region.rect.size.y << "\n";
+  }
+  manifest.close();
+  if (!manifest) {
+    std::cerr << "[TextureAtlas] Can't write the atlas manifest: " << manifestFile << "\n";
+    std::filesystem::remove(manifestFile, error);
+    return false;
+  }
+  return true;
+}
+
+bool
+TextureAtlas::loadFromFile(const std::string& manifestFile, uint64_t signature) {
+  std::ifstream manifest(manifestFile);
+  if (!manifest) {
+    return false;
+  }
+
+  std::string tag;
+  int version = 0;
+  uint64_t storedSignature = 0;
+  size_t pageCount = 0;
+  if (!(manifest >> tag >> version) || tag != "HorchataAtlas" || version != 2 ||
+      !(manifest >> tag >> storedSignature) || tag != "signature" || storedSignature != signature ||
+      !(manifest >> tag >> pageCount) || tag != "pages") {
+    return false;
+  }
+
+  std::vector<sf::Image> pages(pageCount);
+  for (size_t page = 0; page < pageCount; ++page) {
+    std::string pageFile;
+    if (!(manifest >> tag >> std::quoted(pageFile)) || tag != "page" || !pages[page].loadFromFile(pageFile)) {
+      return false;
+    }
+  }
+
+  std::unordered_map<std::string, Region> regions;
+  std::string name;
+  Region region;
+  while (manifest >> tag >> std::quoted(name) >> region.page
+                  >> region.rect.position.x >> region.rect.position.y
+                  >> region.rect.size.x >> region.rect.size.y) {
+    if (tag != "region" || region.page >= pageCount) {
+      return false;
+    }
+    regions[name] = region;
+  }
+
+  m_pages = std::move(pages);
+  m_regions = std::move(regions);
+  m_pending.clear();
+  return true;
+}
+
+uint64_t
+TextureAtlas::computeSignature(const std::vector<std::string>& files) {
+  // FNV-1a over every path, size and write time
+  uint64_t hash = 14695981039346656037ull;
+  auto mix = [&hash](const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+      hash ^= bytes[i];
+      hash *= 1099511628211ull;
+    }
+  };
+
+  for (const std::string& file : files) {
+    mix(file.data(), file.size());
+
+    std::error_code error;
+    const uint64_t size = static_cast<uint64_t>(std::filesystem::file_size(file, error));
+    const uint64_t fileSize = error ? 0 : size;
+    const auto writeTime = std::filesystem::last_write_time(file, error);
+    const int64_t ticks = error ? 0 : static_cast<int64_t>(writeTime.time_since_epoch().count());
+    mix(&fileSize, sizeof(fileSize));
+    mix(&ticks, sizeof(ticks));
+  }
+  return hash;
+}
@@ -0,0 +1,140 @@
+#include "Threading/ThreadPool.h"
+#include "Profiler.h"
+
+namespace {
+	/**
+	 * @brief Queue owned by the current thread, 0 for threads outside the pool.
+	 */
+	thread_local size_t t_queueIndex = 0;
+}
+
+ThreadPool::ThreadPool(unsigned int workerCount) {
+	// Workers record profiler zones: create the profiler first so it is destroyed after them
+	Profiler::getInstance();
+
+	// Queue 0 is fed by the main thread (and any other non-worker thread)
+	for (unsigned int i = 0; i <= workerCount; ++i) {
+		m_queues.push_back(EngineUtilities::MakeUnique<WorkQueue>());
+	}
+	for (unsigned int i = 0; i < workerCount; ++i) {
+		m_workers.emplace_back(&ThreadPool::workerLoop, this, static_cast<size_t>(i + 1));
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_running = false;
+	}
+	m_wakeUp.notify_all();
+
+	for (auto& worker : m_workers) {
+		worker.join();
+	}
+}
+
+ThreadPool&
+ThreadPool::getInstance() {
+	static ThreadPool instance(std::thread::hardware_concurrency() > 1
+	                           ? std::thread::hardware_concurrency() - 1
+	                           : 0);
+	return instance;
+}
+
+void
+ThreadPool::submit(std::function<void()> job, JobCounter* counter) {
+	if (m_workers.empty()) {
+		Job inlineJob{ std::move(job), counter };
+		execute(inlineJob);
+		return;
+	}
+
+	WorkQueue& queue = *m_queues[currentQueueIndex()];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(Job{ std::move(job), counter });
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_pendingJobs.fetch_add(1, std::memory_order_relaxed);
+	}
+	m_wakeUp.notify_one();
+}
+
+void
+ThreadPool::wait(const JobCounter& counter) {
+	const size_t queueIndex = currentQueueIndex();
+	Job job;
+	while (counter.load(std::memory_order_acquire) > 0) {
+		if (findJob(queueIndex, job)) {
+			execute(job);
+		}
+		else {
+			std::this_thread::yield();
+		}
+	}
+}
+
+void
+ThreadPool::workerLoop(size_t queueIndex) {
+	t_queueIndex = queueIndex;
+	Profiler::getInstance().setThreadName("Worker " + std::to_string(queueIndex));
+	Job job;
+
+	while (true) {
+		if (findJob(queueIndex, job)) {
+			execute(job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_wakeUp.wait(lock, [this]() {
+			return !m_running || m_pendingJobs.load(std::memory_order_relaxed) > 0;
+		});
+		if (!m_running && m_pendingJobs.load(std::memory_order_relaxed) == 0) {
+			return;
+		}
+	}
+}
+
+bool
+ThreadPool::findJob(size_t queueIndex, Job& job) {
+	// Own queue first, newest job (LIFO keeps the data it touches in cache)
+	{
+		WorkQueue& own = *m_queues[queueIndex];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.jobs.empty()) {
+			job = std::move(own.jobs.back());
+			own.jobs.pop_back();
+			m_pendingJobs.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	// Steal the oldest job of another queue
+	for (size_t offset = 1; offset < m_queues.size(); ++offset) {
+		WorkQueue& victim = *m_queues[(queueIndex + offset) % m_queues.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.jobs.empty()) {
+			job = std::move(victim.jobs.front());
+			victim.jobs.pop_front();
+			m_pendingJobs.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+void
+ThreadPool::execute(Job& job) {
+	job.function();
+	job.function = nullptr;
+	if (job.counter) {
+		job.counter->fetch_sub(1, std::memory_order_release);
+	}
+}
+
+size_t
+ThreadPool::currentQueueIndex() const {
+	return t_queueIndex < m_queues.size() ? t_queueIndex : 0;
+}
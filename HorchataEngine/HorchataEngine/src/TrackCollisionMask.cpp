@@ -0,0 +1,244 @@
+#include "TrackCollisionMask.h"
+#include "AssetCache.h"
+#include <cstring>
+#include <limits>
+
+namespace {
+  /**
+   * @brief Chamfer distance (1 / sqrt 2 steps) from every pixel to the nearest seed.
+   * @param seeds True for the pixels the distance is measured to.
+   * @param distances Output, one value per pixel.
+   */
+  void
+    chamferDistance(unsigned int width,
+                    unsigned int height,
+                    const std::vector<bool>& seeds,
+                    std::vector<float>& distances) {
+    const float far = std::numeric_limits<float>::max() * 0.5f;
+    const float diagonal = 1.41421356f;
+    distances.assign(static_cast<size_t>(width) * height, far);
+    for (size_t i = 0; i < distances.size(); ++i) {
+      if (seeds[i]) {
+        distances[i] = 0.0f;
+      }
+    }
+
+    auto relax = [&](size_t index, int x, int y, float step) {
+      if (x >= 0 && y >= 0 && x < static_cast<int>(width) && y < static_cast<int>(height)) {
+        const float candidate = distances[static_cast<size_t>(y) * width + x] + step;
+        if (candidate < distances[index]) {
+          distances[index] = candidate;
+        }
+      }
+    };
+
+    // Forward pass: neighbours above and to the left
+    for (int y = 0; y < static_cast<int>(height); ++y) {
+      for (int x = 0; x < static_cast<int>(width); ++x) {
+        const size_t index = static_cast<size_t>(y) * width + x;
+        relax(index, x - 1, y, 1.0f);
+        relax(index, x - 1, y - 1, diagonal);
+        relax(index, x, y - 1, 1.0f);
+        relax(index, x + 1, y - 1, diagonal);
+      }
+    }
+    // Backward pass: neighbours below and to the right
+    for (int y = static_cast<int>(height) - 1; y >= 0; --y) {
+      for (int x = static_cast<int>(width) - 1; x >= 0; --x) {
+        const size_t index = static_cast<size_t>(y) * width + x;
+        relax(index, x + 1, y, 1.0f);
+        relax(index, x + 1, y + 1, diagonal);
+        relax(index, x, y + 1, 1.0f);
+        relax(index, x - 1, y + 1, diagonal);
+      }
+    }
+  }
+}
+
+bool
+TrackCollisionMask::loadFromFile(const std::string& fileName,
+                                 const sf::Color& deathColor,
+                                 bool withDistanceField) {
+  // The entry depends on the death color and on the distance field, not only on the image
+  AssetCache& cache = AssetCache::getInstance();
+  const std::string kind = "mask" + std::to_string(deathColor.toInteger()) + (withDistanceField ? "sdf" : "");
+  MappedFile file;
+  const uint8_t* payload = nullptr;
+  size_t payloadSize = 0;
+  if (cache.find(fileName, kind, file, payload, payloadSize) && deserialize(payload, payloadSize)) {
+    return true;
+  }
+
+  sf::Image image;
+  if (!cache.loadImage(fileName, image)) {
+    // Not fatal: without a mask the track simply has no death zones
+    std::cerr << "[TrackCollisionMask] Can't load the track image: " << fileName << ". The mask is left unchanged.\n";
+    return false;
+  }
+  build(image, deathColor);
+  if (withDistanceField) {
+    buildDistanceField();
+  }
+
+  const std::vector<uint8_t> blob = serialize();
+  cache.store(fileName, kind, blob.data(), blob.size());
+  return true;
+}
+
+void
+TrackCollisionMask::build(const sf::Image& image, const sf::Color& deathColor) {
+  build(image.getSize().x, image.getSize().y, image.getPixelsPtr(), deathColor);
+}
+
+void
+TrackCollisionMask::build(unsigned int width,
+                          unsigned int height,
+                          const uint8_t* pixels,
+                          const sf::Color& deathColor) {
+  m_width = width;
+  m_height = height;
+  m_wordsPerRow = (static_cast<size_t>(width) + 63) / 64;
+  m_bits.assign(m_wordsPerRow * height, 0);
+  m_distanceField.clear();
+
+  if (!pixels) {
+    return;
+  }
+
+  const uint32_t death = static_cast<uint32_t>(deathColor.r) |
+                         static_cast<uint32_t>(deathColor.g) << 8 |
+                         static_cast<uint32_t>(deathColor.b) << 16 |
+                         static_cast<uint32_t>(deathColor.a) << 24;
+  for (unsigned int y = 0; y < height; ++y) {
+    const uint8_t* row = pixels + static_cast<size_t>(y) * width * 4;
+    uint64_t* words = &m_bits[y * m_wordsPerRow];
+    for (unsigned int x = 0; x < width; ++x) {
+      const uint8_t* pixel = row + static_cast<size_t>(x) * 4;
+      const uint32_t color = static_cast<uint32_t>(pixel[0]) |
+                             static_cast<uint32_t>(pixel[1]) << 8 |
+                             static_cast<uint32_t>(pixel[2]) << 16 |
+                             static_cast<uint32_t>(pixel[3]) << 24;
+      if (color == death) {
+        words[x >> 6] |= uint64_t(1) << (x & 63);
+      }
+    }
+  }
+}
+
+void
+TrackCollisionMask::buildDistanceField() {
+  const size_t count = static_cast<size_t>(m_width) * m_height;
+  std::vector<bool> deathPixels(count);
+  std::vector<bool> roadPixels(count);
+  for (unsigned int y = 0; y < m_height; ++y) {
+    for (unsigned int x = 0; x < m_width; ++x) {
+      const bool death = isDeathPixel(x, y);
+      deathPixels[static_cast<size_t>(y) * m_width + x] = death;
+      roadPixels[static_cast<size_t>(y) * m_width + x] = !death;
+    }
+  }
+
+  // Road pixels measure to the nearest death pixel, death pixels to the nearest road pixel
+  std::vector<float> toDeath;
+  std::vector<float> toRoad;
+  chamferDistance(m_width, m_height, deathPixels, toDeath);
+  chamferDistance(m_width, m_height, roadPixels, toRoad);
+
+  m_distanceField.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    m_distanceField[i] = deathPixels[i] ? -toRoad[i] : toDeath[i];
+  }
+}
+
+std::vector<uint8_t>
+TrackCollisionMask::serialize() const {
+  // width, height, distance field flag, then the bit words and the distances
+  const uint32_t header[3] = { m_width, m_height, m_distanceField.empty() ? 0u : 1u };
+  const size_t bitBytes = m_bits.size() * sizeof(uint64_t);
+  const size_t fieldBytes = m_distanceField.size() * sizeof(float);
+  std::vector<uint8_t> blob(sizeof(header) + bitBytes + fieldBytes);
+  std::memcpy(blob.data(), header, sizeof(header));
+  if (bitBytes > 0) {
+    std::memcpy(blob.data() + sizeof(header), m_bits.data(), bitBytes);
+  }
+  if (fieldBytes > 0) {
+    std::memcpy(blob.data() + sizeof(header) + bitBytes, m_distanceField.data(), fieldBytes);
+  }
+  return blob;
+}
+
+bool
+TrackCollisionMask::deserialize(const uint8_t* data, size_t size) {
+  uint32_t header[3];
+  if (size < sizeof(header)) {
+    return false;
+  }
+  std::memcpy(header, data, sizeof(header));
+
+  const size_t wordsPerRow = (static_cast<size_t>(header[0]) + 63) / 64;
+  const size_t bitBytes = wordsPerRow * header[1] * sizeof(uint64_t);
+  const size_t fieldBytes = header[2] ? static_cast<size_t>(header[0]) * header[1] * sizeof(float) : 0;
+  if (size != sizeof(header) + bitBytes + fieldBytes) {
+    return false;
+  }
+
+  m_width = header[0];
+  m_height = header[1];
+  m_wordsPerRow = wordsPerRow;
+  m_bits.resize(bitBytes / sizeof(uint64_t));
+  m_distanceField.resize(fieldBytes / sizeof(float));
+  if (bitBytes > 0) {
+    std::memcpy(m_bits.data(), data + sizeof(header), bitBytes);
+  }
+  if (fieldBytes > 0) {
+    std::memcpy(m_distanceField.data(), data + sizeof(header) + bitBytes, fieldBytes);
+  }
+  return true;
+}
+
+void
+TrackCollisionMask::setWorldBounds(const EngineMath::Vector2& position, const EngineMath::Vector2& size) {
+  m_worldPosition = position;
+  m_pixelsPerUnit = EngineMath::Vector2(size.x > 0.f ? m_width / size.x : 0.f,
+                                        size.y > 0.f ? m_height / size.y : 0.f);
+  const float averagePixels = (m_pixelsPerUnit.x + m_pixelsPerUnit.y) * 0.5f;
+  m_unitsPerPixel = averagePixels > 0.f ? 1.0f / averagePixels : 1.0f;
+}
+
+bool
+TrackCollisionMask::worldToPixel(const EngineMath::Vector2& worldPosition,
+                                 unsigned int& x,
+                                 unsigned int& y) const {
+  const float pixelX = (worldPosition.x - m_worldPosition.x) * m_pixelsPerUnit.x;
+  const float pixelY = (worldPosition.y - m_worldPosition.y) * m_pixelsPerUnit.y;
+  if (!(pixelX >= 0.f && pixelY >= 0.f && pixelX < m_width && pixelY < m_height)) {
+    return false;
+  }
+  x = static_cast<unsigned int>(pixelX);
+  y = static_cast<unsigned int>(pixelY);
+  return true;
+}
+
+bool
+TrackCollisionMask::isDeath(const EngineMath::Vector2& worldPosition) const {
+  unsigned int x;
+  unsigned int y;
+  return worldToPixel(worldPosition, x, y) && isDeathPixel(x, y);
+}
+
+bool
+TrackCollisionMask::contains(const EngineMath::Vector2& worldPosition) const {
+  unsigned int x;
+  unsigned int y;
+  return worldToPixel(worldPosition, x, y);
+}
+
+float
+TrackCollisionMask::signedDistance(const EngineMath::Vector2& worldPosition) const {
+  unsigned int x;
+  unsigned int y;
+  if (m_distanceField.empty() || !worldToPixel(worldPosition, x, y)) {
+    return 0.0f;
+  }
+  return m_distanceField[static_cast<size_t>(y) * m_width + x] * m_unitsPerPixel;
+}
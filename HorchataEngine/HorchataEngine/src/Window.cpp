@@ -1,4 +1,4 @@
-#include <window.h>
+#include <Window.h>
 #include <EngineGUI.h>
 
 Window::Window(int width, int height, const std::string& title) {
@@ -1,8 +1,52 @@
 #include "BaseApp.h"
+#include "Profiler.h"
+#include <cstdlib>
+#include <cstring>
 
+/**
+ * Usage: HorchataEngine [--headless] [--frames N] [--timestep SECONDS] [--trace FILE] [--memory-report FILE]
+ * --headless runs the simulation without window or GUI at a fixed timestep.
+ * --trace writes the last profiler zones as a Chrome trace (JSON) on exit.
+ * --memory-report writes the MemoryTracker counters (JSON) on exit; per-object counts
+ *   need HORCHATA_MEMORY_TRACKER=1, which is the default only in Debug builds.
+ */
 int 
-main()
+main(int argc, char* argv[])
 {
+  bool headless = false;
+  size_t frameCount = 120 * 60;
+  float timeStep = 1.f / 120.f;
+  std::string traceFile;
+  std::string memoryReportFile;
+
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--headless") == 0) {
+      headless = true;
+    }
+    else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+      frameCount = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+    }
+    else if (std::strcmp(argv[i], "--timestep") == 0 && i + 1 < argc) {
+      timeStep = std::strtof(argv[++i], nullptr);
+    }
+    else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+      traceFile = argv[++i];
+    }
+    else if (std::strcmp(argv[i], "--memory-report") == 0 && i + 1 < argc) {
+      memoryReportFile = argv[++i];
+    }
+  }
+
   BaseApp app;
-  return app.run();
+  const int result = headless ? app.runHeadless(frameCount, timeStep > 0.f ? timeStep : 1.f / 120.f)
+                              : app.run();
+
+  if (!traceFile.empty()) {
+    Profiler::getInstance().exportChromeTrace(traceFile);
+  }
+  if (!memoryReportFile.empty() &&
+      !EngineUtilities::MemoryTracker::getInstance().writeJson(memoryReportFile)) {
+    std::cerr << "Can't write the memory report: " << memoryReportFile << "\n";
+  }
+  return result;
 }